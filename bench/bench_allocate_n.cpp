@@ -0,0 +1,106 @@
+#include "bench_pch.h"
+
+#include "wmcv_memory/wmcv_arena_allocator.h"
+#include "wmcv_memory/wmcv_lockless_arena_allocator.h"
+#include "wmcv_memory/wmcv_block_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr size_t s_alloc_count = 1'000'000;
+	constexpr size_t s_alloc_size = 16;
+	constexpr size_t s_alloc_alignment = 16;
+	constexpr size_t s_batch_size = 256;
+
+	auto MakeBlock(std::vector<std::byte>& storage) -> wmcv::Block
+	{
+		return {.address = wmcv::ptr_to_address(storage.data()), .size = storage.size()};
+	}
+
+	template<typename Arena>
+	void AllocateSingle(Arena& arena)
+	{
+		for (size_t i = 0; i < s_alloc_count; ++i)
+		{
+			benchmark::DoNotOptimize(arena.allocate_aligned(s_alloc_size, s_alloc_alignment));
+		}
+	}
+
+	template<typename Arena>
+	void AllocateBatched(Arena& arena)
+	{
+		std::array<wmcv::Block, s_batch_size> blocks = {};
+		for (size_t i = 0; i < s_alloc_count; i += s_batch_size)
+		{
+			const size_t count = std::min(s_batch_size, s_alloc_count - i);
+			benchmark::DoNotOptimize(arena.allocate_n(count, s_alloc_size, s_alloc_alignment, blocks));
+			benchmark::DoNotOptimize(blocks.data());
+		}
+	}
+}
+
+template<typename Arena, bool Batched>
+static void BM_ArenaAllocate(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_alloc_count * s_alloc_size + s_alloc_alignment);
+	Arena arena(MakeBlock(storage));
+
+	for (auto _ : state)
+	{
+		if constexpr (Batched)
+		{
+			AllocateBatched(arena);
+		}
+		else
+		{
+			AllocateSingle(arena);
+		}
+		arena.reset();
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_alloc_count));
+}
+
+template<bool Batched>
+static void BM_BlockAllocate(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_alloc_count * s_alloc_size + s_alloc_alignment);
+	wmcv::BlockAllocator pool(MakeBlock(storage), s_alloc_size, s_alloc_alignment);
+	std::vector<wmcv::Block> blocks(s_alloc_count);
+
+	for (auto _ : state)
+	{
+		if constexpr (Batched)
+		{
+			for (size_t i = 0; i < s_alloc_count; i += s_batch_size)
+			{
+				const size_t count = std::min(s_batch_size, s_alloc_count - i);
+				benchmark::DoNotOptimize(pool.allocate_n(count, std::span(blocks).subspan(i, count)));
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < s_alloc_count; ++i)
+			{
+				blocks[i] = pool.allocate();
+			}
+		}
+		benchmark::DoNotOptimize(blocks.data());
+
+		state.PauseTiming();
+		for (const auto& block : blocks)
+		{
+			pool.free(wmcv::address_to_ptr(block.address));
+		}
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_alloc_count));
+}
+
+BENCHMARK_TEMPLATE(BM_ArenaAllocate, wmcv::ArenaAllocator, false);
+BENCHMARK_TEMPLATE(BM_ArenaAllocate, wmcv::ArenaAllocator, true);
+BENCHMARK_TEMPLATE(BM_ArenaAllocate, wmcv::LocklessArenaAllocator, false);
+BENCHMARK_TEMPLATE(BM_ArenaAllocate, wmcv::LocklessArenaAllocator, true);
+BENCHMARK_TEMPLATE(BM_BlockAllocate, false);
+BENCHMARK_TEMPLATE(BM_BlockAllocate, true);
@@ -0,0 +1,98 @@
+#include "bench_pch.h"
+
+#include "wmcv_memory/wmcv_bitmap_block_allocator.h"
+#include "wmcv_memory/wmcv_block_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr size_t s_chunk_size = 64;
+	constexpr size_t s_ops_per_iteration = 4096;
+
+	auto MakeStorage(size_t chunkCount) -> std::vector<std::byte>
+	{
+		// room for the bitmap pool's metadata as well, so both pools get the same block
+		return std::vector<std::byte>(chunkCount * s_chunk_size + chunkCount / 8 + 128);
+	}
+
+	auto MakeBlock(std::vector<std::byte>& storage) -> wmcv::Block
+	{
+		return {.address = wmcv::ptr_to_address(storage.data()), .size = storage.size()};
+	}
+
+	// Deterministic pseudo random slot order so both pools see the same pattern
+	auto MakeSlotOrder(size_t count) -> std::vector<size_t>
+	{
+		std::vector<size_t> order(s_ops_per_iteration);
+		uint64_t state = 0x9e3779b97f4a7c15;
+		for (auto& slot : order)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			slot = state % count;
+		}
+		return order;
+	}
+}
+
+// Keeps the pool half full and frees then reallocates chunks at random, so
+// frees land all over the pool the way they do for long lived objects.
+// Pool sizes step from cache resident to well past the LLC, run under
+// `perf stat -e cache-misses` for the miss counts.
+template<typename Pool>
+static void BM_FixedPoolChurn(benchmark::State& state)
+{
+	const auto chunkCount = static_cast<size_t>(state.range(0));
+	auto storage = MakeStorage(chunkCount);
+	Pool pool(MakeBlock(storage), s_chunk_size, 16);
+
+	std::vector<void*> live(chunkCount / 2);
+	for (auto& ptr : live)
+	{
+		ptr = wmcv::address_to_ptr(pool.allocate().address);
+	}
+
+	const auto order = MakeSlotOrder(live.size());
+	for (auto _ : state)
+	{
+		for (const size_t slot : order)
+		{
+			pool.free(live[slot]);
+			live[slot] = wmcv::address_to_ptr(pool.allocate().address);
+		}
+		benchmark::DoNotOptimize(live.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_ops_per_iteration));
+}
+
+// Fills the pool then frees all of it, the pattern a per frame pool sees
+template<typename Pool>
+static void BM_FixedPoolFillDrain(benchmark::State& state)
+{
+	const auto chunkCount = static_cast<size_t>(state.range(0));
+	auto storage = MakeStorage(chunkCount);
+	Pool pool(MakeBlock(storage), s_chunk_size, 16);
+	std::vector<void*> live(chunkCount);
+
+	for (auto _ : state)
+	{
+		for (auto& ptr : live)
+		{
+			ptr = wmcv::address_to_ptr(pool.allocate().address);
+		}
+		for (auto* ptr : live)
+		{
+			pool.free(ptr);
+		}
+		benchmark::DoNotOptimize(live.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(chunkCount) * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_FixedPoolChurn, wmcv::BlockAllocator)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FixedPoolChurn, wmcv::BitmapBlockAllocator)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FixedPoolFillDrain, wmcv::BlockAllocator)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FixedPoolFillDrain, wmcv::BitmapBlockAllocator)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
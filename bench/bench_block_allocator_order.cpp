@@ -0,0 +1,103 @@
+#include "bench_pch.h"
+
+#include "wmcv_memory/wmcv_block_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr size_t s_chunk_size = 64;
+
+	enum class PoolState
+	{
+		Filled,
+		Churned,
+		ChurnedSorted
+	};
+
+	// Objects are walked in the order they were allocated, the way a system that
+	// appends to a list of pool objects would iterate them
+	struct Objects
+	{
+		explicit Objects(size_t count)
+			: storage(count * s_chunk_size + s_chunk_size)
+			, pool({.address = wmcv::ptr_to_address(storage.data()), .size = storage.size()}, s_chunk_size, s_chunk_size)
+			, ptrs(count)
+		{
+		}
+
+		void fill()
+		{
+			for (auto& ptr : ptrs)
+			{
+				ptr = static_cast<uint64_t*>(wmcv::address_to_ptr(pool.allocate().address));
+				*ptr = 1;
+			}
+		}
+
+		// Frees half the objects in a pseudo random order and allocates them again
+		void churn(bool sorted)
+		{
+			const size_t half = ptrs.size() / 2;
+
+			uint64_t state = 0x9e3779b97f4a7c15;
+			for (size_t i = 0; i < half; ++i)
+			{
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				std::swap(ptrs[i], ptrs[i + state % (ptrs.size() - i)]);
+			}
+
+			for (size_t i = 0; i < half; ++i)
+			{
+				pool.free(ptrs[i]);
+			}
+
+			if (sorted)
+			{
+				pool.sort_free_list();
+			}
+
+			// the reallocated objects go on the end, as they would in the owning system
+			std::rotate(ptrs.begin(), ptrs.begin() + static_cast<std::ptrdiff_t>(half), ptrs.end());
+			for (size_t i = ptrs.size() - half; i < ptrs.size(); ++i)
+			{
+				ptrs[i] = static_cast<uint64_t*>(wmcv::address_to_ptr(pool.allocate().address));
+				*ptrs[i] = 1;
+			}
+
+			std::sort(ptrs.begin(), ptrs.begin() + static_cast<std::ptrdiff_t>(ptrs.size() - half));
+		}
+
+		std::vector<std::byte> storage;
+		wmcv::BlockAllocator pool;
+		std::vector<uint64_t*> ptrs;
+	};
+}
+
+template<PoolState State>
+static void BM_BlockIterate(benchmark::State& state)
+{
+	Objects objects(static_cast<size_t>(state.range(0)));
+	objects.fill();
+	if constexpr (State != PoolState::Filled)
+	{
+		objects.churn(State == PoolState::ChurnedSorted);
+	}
+
+	for (auto _ : state)
+	{
+		uint64_t sum = 0;
+		for (const uint64_t* ptr : objects.ptrs)
+		{
+			sum += *ptr;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_BlockIterate, PoolState::Filled)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BlockIterate, PoolState::Churned)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BlockIterate, PoolState::ChurnedSorted)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
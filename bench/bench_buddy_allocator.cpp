@@ -0,0 +1,97 @@
+#include "bench_pch.h"
+
+#include "wmcv_memory/wmcv_buddy_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr size_t s_heap_size = 32_MB;
+	constexpr size_t s_live_blocks = 100'000;
+	constexpr std::array<size_t, 4> s_sizes = { 16, 48, 100, 240 };
+
+	// A heap with s_live_blocks of mixed sizes allocated, with every fourth one
+	// freed again so there are holes of every order scattered through it
+	struct PopulatedBuddy
+	{
+		PopulatedBuddy()
+			: storage(s_heap_size + 16)
+			, buddy({.address = wmcv::align(wmcv::ptr_to_address(storage.data()), 16), .size = s_heap_size}, 16)
+			, live(s_live_blocks)
+		{
+			for (size_t i = 0; i < live.size(); ++i)
+			{
+				live[i] = wmcv::address_to_ptr(buddy.allocate(s_sizes[i % s_sizes.size()]).address);
+			}
+
+			for (size_t i = 0; i < live.size(); i += 4)
+			{
+				buddy.free(std::exchange(live[i], nullptr));
+			}
+		}
+
+		std::vector<std::byte> storage;
+		wmcv::BuddyAllocator buddy;
+		std::vector<void*> live;
+	};
+}
+
+static void BM_BuddyAllocateFree(benchmark::State& state)
+{
+	PopulatedBuddy heap;
+	const auto size = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		const wmcv::Block block = heap.buddy.allocate(size);
+		benchmark::DoNotOptimize(block);
+		heap.buddy.free(wmcv::address_to_ptr(block.address));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+// Replaces live blocks in a pseudo random order with blocks of a different size
+static void BM_BuddyChurn(benchmark::State& state)
+{
+	PopulatedBuddy heap;
+	uint64_t random = 0x9e3779b97f4a7c15;
+	size_t next_size = 0;
+
+	for (auto _ : state)
+	{
+		random ^= random << 13;
+		random ^= random >> 7;
+		random ^= random << 17;
+
+		void*& slot = heap.live[random % heap.live.size()];
+		heap.buddy.free(slot);
+		slot = wmcv::address_to_ptr(heap.buddy.allocate(s_sizes[next_size++ % s_sizes.size()]).address);
+		benchmark::DoNotOptimize(slot);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+// Grows a buffer by doubling from 64 bytes to 64 KiB, the way a growable
+// message buffer would, inside the populated heap
+static void BM_BuddyReallocateGrow(benchmark::State& state)
+{
+	PopulatedBuddy heap;
+
+	for (auto _ : state)
+	{
+		wmcv::Block block = heap.buddy.allocate(64);
+		for (size_t size = 128; size <= 64_kB; size *= 2)
+		{
+			block = heap.buddy.reallocate(block, size);
+		}
+		benchmark::DoNotOptimize(block);
+		heap.buddy.free(wmcv::address_to_ptr(block.address));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BuddyAllocateFree)->Arg(16)->Arg(240)->Arg(4096);
+BENCHMARK(BM_BuddyChurn);
+BENCHMARK(BM_BuddyReallocateGrow);
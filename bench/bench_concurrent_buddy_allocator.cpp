@@ -0,0 +1,90 @@
+#include "bench_pch.h"
+
+#include "wmcv_memory/wmcv_concurrent_buddy_allocator.h"
+#include "wmcv_memory/wmcv_buddy_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr size_t s_heap_size = 16_MB;
+	constexpr size_t s_alignment = 64;
+	constexpr size_t s_held_per_thread = 16;
+
+	// spread over seven orders, 64 bytes to 4 KiB
+	constexpr std::array<size_t, 8> s_sizes = { 64, 4096, 128, 1024, 256, 2048, 512, 64 };
+
+	alignas(64) std::array<std::byte, s_heap_size> s_storage = {};
+	std::array<uint8_t, wmcv::BuddyAllocator::metadata_size(s_heap_size, s_alignment)> s_metadata = {};
+
+	alignas(64) std::array<std::byte, s_heap_size> s_concurrent_storage = {};
+	std::array<uint8_t, wmcv::ConcurrentBuddyAllocator::metadata_size(s_heap_size, s_alignment)> s_concurrent_metadata = {};
+
+	// Baseline, the single threaded buddy behind a global lock
+	struct MutexBuddyAllocator
+	{
+		auto allocate(size_t size) noexcept -> wmcv::Block
+		{
+			std::scoped_lock lock(mutex);
+			return buddy.allocate(size);
+		}
+
+		void free(void* ptr) noexcept
+		{
+			std::scoped_lock lock(mutex);
+			buddy.free(ptr);
+		}
+
+		std::mutex mutex;
+		wmcv::BuddyAllocator buddy
+		{
+			{.address = wmcv::ptr_to_address(s_storage.data()), .size = s_storage.size()},
+			{.address = wmcv::ptr_to_address(s_metadata.data()), .size = s_metadata.size()},
+			s_alignment
+		};
+	};
+
+	MutexBuddyAllocator s_mutex_buddy;
+	wmcv::ConcurrentBuddyAllocator s_concurrent_buddy(
+		{.address = wmcv::ptr_to_address(s_concurrent_storage.data()), .size = s_concurrent_storage.size()},
+		{.address = wmcv::ptr_to_address(s_concurrent_metadata.data()), .size = s_concurrent_metadata.size()},
+		s_alignment);
+
+	// Each thread keeps a ring of live blocks and replaces the oldest every
+	// iteration with a block of the next size, so every thread works across
+	// all the orders and allocations interleave with frees
+	template<typename Buddy>
+	void MixedOrderChurn(benchmark::State& state, Buddy& buddy)
+	{
+		std::array<void*, s_held_per_thread> held = {};
+		size_t slot = 0;
+		size_t next_size = static_cast<size_t>(state.thread_index());
+
+		for (auto _ : state)
+		{
+			buddy.free(held[slot]);
+			held[slot] = wmcv::address_to_ptr(buddy.allocate(s_sizes[next_size++ % s_sizes.size()]).address);
+			benchmark::DoNotOptimize(held[slot]);
+			slot = (slot + 1) % s_held_per_thread;
+		}
+
+		for (void* ptr : held)
+		{
+			buddy.free(ptr);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+static void BM_ConcurrentBuddyChurn(benchmark::State& state)
+{
+	MixedOrderChurn(state, s_concurrent_buddy);
+}
+
+static void BM_MutexBuddyChurn(benchmark::State& state)
+{
+	MixedOrderChurn(state, s_mutex_buddy);
+}
+
+BENCHMARK(BM_ConcurrentBuddyChurn)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_MutexBuddyChurn)->ThreadRange(1, 16)->UseRealTime();
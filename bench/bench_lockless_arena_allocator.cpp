@@ -0,0 +1,67 @@
+#include "bench_pch.h"
+
+#include "wmcv_memory/wmcv_lockless_arena_allocator.h"
+#include "wmcv_memory/wmcv_thread_local_arena_buffer.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr size_t s_alloc_size = 32;
+
+	// The arenas never touch the memory they hand out, so a large fake range
+	// keeps them from running dry however many iterations the benchmark runs
+	constexpr wmcv::Block s_address_range = {.address = 0x00010000, .size = size_t{1} << 44};
+
+	wmcv::LocklessArenaAllocator s_arena(s_address_range);
+}
+
+static void BM_LocklessArenaShared(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+	{
+		s_arena.reset();
+	}
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(s_arena.allocate(s_alloc_size));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+// Alignment above the granule takes the compare_exchange loop
+static void BM_LocklessArenaSharedOverAligned(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+	{
+		s_arena.reset();
+	}
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(s_arena.allocate_aligned(s_alloc_size, 2 * wmcv::LocklessArenaAllocator::DefaultGranule));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_LocklessArenaThreadLocalBuffer(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+	{
+		s_arena.reset();
+	}
+
+	wmcv::ThreadLocalArenaBuffer buffer(s_arena);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(buffer.allocate(s_alloc_size));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_LocklessArenaShared)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_LocklessArenaSharedOverAligned)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_LocklessArenaThreadLocalBuffer)->ThreadRange(1, 8)->UseRealTime();
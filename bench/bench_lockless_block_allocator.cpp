@@ -0,0 +1,121 @@
+#include "bench_pch.h"
+
+#include "wmcv_memory/wmcv_lockless_block_allocator.h"
+#include "wmcv_memory/wmcv_block_allocator.h"
+#include "wmcv_memory/wmcv_magazine_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr size_t s_chunk_size = 64;
+	constexpr size_t s_held_per_thread = 16;
+
+	alignas(64) std::array<std::byte, 1_MB> s_storage = {};
+	const wmcv::Block s_block = {.address = wmcv::ptr_to_address(s_storage.data()), .size = s_storage.size()};
+
+	// Baseline, the single threaded pool behind a lock
+	struct MutexBlockAllocator
+	{
+		auto allocate() noexcept -> wmcv::Block
+		{
+			std::scoped_lock lock(mutex);
+			return pool.allocate();
+		}
+
+		void free(void* ptr) noexcept
+		{
+			std::scoped_lock lock(mutex);
+			pool.free(ptr);
+		}
+
+		std::mutex mutex;
+		wmcv::BlockAllocator pool{s_block, s_chunk_size, 16};
+	};
+
+	wmcv::LocklessBlockAllocator s_lockless_pool(s_block, s_chunk_size, 16);
+	MutexBlockAllocator s_mutex_pool;
+
+	alignas(64) std::array<std::byte, 1_MB> s_magazine_storage = {};
+	wmcv::LocklessBlockAllocator s_magazine_pool({.address = wmcv::ptr_to_address(s_magazine_storage.data()), .size = s_magazine_storage.size()}, s_chunk_size, 16);
+	wmcv::MagazineDepot s_depot(s_magazine_pool);
+
+	// Each thread keeps a small ring of live chunks and replaces the oldest
+	// every iteration, so allocations and frees interleave across threads
+	template<typename Pool>
+	void Churn(benchmark::State& state, Pool& pool)
+	{
+		std::array<void*, s_held_per_thread> held = {};
+		size_t slot = 0;
+
+		for (auto _ : state)
+		{
+			pool.free(held[slot]);
+			held[slot] = wmcv::address_to_ptr(pool.allocate().address);
+			benchmark::DoNotOptimize(held[slot]);
+			slot = (slot + 1) % s_held_per_thread;
+		}
+
+		for (void* ptr : held)
+		{
+			pool.free(ptr);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+static void BM_LocklessBlockChurn(benchmark::State& state)
+{
+	Churn(state, s_lockless_pool);
+}
+
+static void BM_MutexBlockChurn(benchmark::State& state)
+{
+	Churn(state, s_mutex_pool);
+}
+
+static void BM_MagazineBlockChurn(benchmark::State& state)
+{
+	wmcv::MagazineCache cache(s_depot);
+	Churn(state, cache);
+}
+
+// Task shaped churn, each thread allocates a batch of chunks then frees them all
+// at the end of the "task", either one free at a time or with a single free_batch
+template<bool Batched>
+static void BM_LocklessBlockTaskChurn(benchmark::State& state)
+{
+	constexpr size_t s_task_size = 128;
+	std::array<wmcv::Block, s_task_size> blocks = {};
+	std::array<void*, s_task_size> ptrs = {};
+
+	for (auto _ : state)
+	{
+		const size_t count = s_lockless_pool.allocate_n(s_task_size, blocks);
+		for (size_t i = 0; i < count; ++i)
+		{
+			ptrs[i] = wmcv::address_to_ptr(blocks[i].address);
+		}
+		benchmark::DoNotOptimize(ptrs.data());
+
+		if constexpr (Batched)
+		{
+			s_lockless_pool.free_batch(std::span(ptrs).first(count));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				s_lockless_pool.free(ptrs[i]);
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_task_size));
+}
+
+BENCHMARK(BM_LocklessBlockChurn)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_MutexBlockChurn)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_MagazineBlockChurn)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LocklessBlockTaskChurn, false)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LocklessBlockTaskChurn, true)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,190 @@
+#include "bench_pch.h"
+#include "wmcv_freelist_first_fit_policy.h"
+#include "wmcv_freelist_best_fit_policy.h"
+
+#include "wmcv_memory/wmcv_memory_resource.h"
+#include "wmcv_memory/wmcv_arena_allocator.h"
+#include "wmcv_memory/wmcv_stack_allocator.h"
+#include "wmcv_memory/wmcv_block_allocator.h"
+#include "wmcv_memory/wmcv_buddy_allocator.h"
+#include "wmcv_memory/wmcv_freelist_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	constexpr int s_element_count = 1000;
+	constexpr size_t s_buffer_size = 4_MB;
+
+	struct VectorWorkload
+	{
+		static void run(std::pmr::memory_resource* resource)
+		{
+			std::pmr::vector<int> values(resource);
+			for (int i = 0; i < s_element_count; ++i)
+			{
+				values.push_back(i);
+			}
+			benchmark::DoNotOptimize(values.data());
+		}
+	};
+
+	struct ReservedVectorWorkload
+	{
+		static void run(std::pmr::memory_resource* resource)
+		{
+			std::pmr::vector<int> values(resource);
+			values.reserve(s_element_count);
+			for (int i = 0; i < s_element_count; ++i)
+			{
+				values.push_back(i);
+			}
+			benchmark::DoNotOptimize(values.data());
+		}
+	};
+
+	struct ListWorkload
+	{
+		static void run(std::pmr::memory_resource* resource)
+		{
+			std::pmr::list<int> values(resource);
+			for (int i = 0; i < s_element_count; ++i)
+			{
+				values.push_back(i);
+			}
+			benchmark::DoNotOptimize(values.back());
+		}
+	};
+
+	struct UnorderedMapWorkload
+	{
+		static void run(std::pmr::memory_resource* resource)
+		{
+			std::pmr::unordered_map<int, int> values(resource);
+			for (int i = 0; i < s_element_count; ++i)
+			{
+				values.emplace(i, i);
+			}
+			benchmark::DoNotOptimize(values.size());
+		}
+	};
+
+	auto MakeBlock(std::vector<std::byte>& storage) -> wmcv::Block
+	{
+		return {.address = wmcv::ptr_to_address(storage.data()), .size = storage.size()};
+	}
+}
+
+template<typename Workload>
+static void BM_NewDeleteResource(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		Workload::run(std::pmr::new_delete_resource());
+	}
+}
+
+template<typename Workload>
+static void BM_MonotonicBufferResource(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_buffer_size);
+	std::pmr::monotonic_buffer_resource resource(storage.data(), storage.size(), std::pmr::null_memory_resource());
+
+	for (auto _ : state)
+	{
+		Workload::run(&resource);
+		resource.release();
+	}
+}
+
+template<typename Workload>
+static void BM_ArenaResource(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_buffer_size);
+	wmcv::ArenaAllocator arena(MakeBlock(storage));
+	wmcv::MemoryResourceAdapter resource(arena);
+
+	for (auto _ : state)
+	{
+		Workload::run(&resource);
+		arena.reset();
+	}
+}
+
+template<typename Workload>
+static void BM_StackResource(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_buffer_size);
+	wmcv::StackAllocator stack(MakeBlock(storage));
+	wmcv::MemoryResourceAdapter resource(stack);
+
+	for (auto _ : state)
+	{
+		Workload::run(&resource);
+	}
+}
+
+template<typename Workload>
+static void BM_BlockResource(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_buffer_size);
+	wmcv::BlockAllocator pool(MakeBlock(storage), 32, 16);
+	wmcv::MemoryResourceAdapter resource(pool);
+
+	for (auto _ : state)
+	{
+		Workload::run(&resource);
+	}
+}
+
+template<typename Workload>
+static void BM_BuddyResource(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_buffer_size);
+	wmcv::BuddyAllocator buddy(MakeBlock(storage), 16);
+	wmcv::MemoryResourceAdapter resource(buddy);
+
+	for (auto _ : state)
+	{
+		Workload::run(&resource);
+	}
+}
+
+template<typename Workload, typename Policy>
+static void BM_FreeListResource(benchmark::State& state)
+{
+	std::vector<std::byte> storage(s_buffer_size);
+	wmcv::FreeListAllocator<Policy> freelist(MakeBlock(storage));
+	wmcv::MemoryResourceAdapter resource(freelist);
+
+	for (auto _ : state)
+	{
+		Workload::run(&resource);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_NewDeleteResource, VectorWorkload);
+BENCHMARK_TEMPLATE(BM_MonotonicBufferResource, VectorWorkload);
+BENCHMARK_TEMPLATE(BM_ArenaResource, VectorWorkload);
+BENCHMARK_TEMPLATE(BM_BuddyResource, VectorWorkload);
+BENCHMARK_TEMPLATE(BM_FreeListResource, VectorWorkload, wmcv::FreeListFirstFitPolicy);
+BENCHMARK_TEMPLATE(BM_FreeListResource, VectorWorkload, wmcv::FreeListBestFitPolicy);
+
+BENCHMARK_TEMPLATE(BM_NewDeleteResource, ReservedVectorWorkload);
+BENCHMARK_TEMPLATE(BM_MonotonicBufferResource, ReservedVectorWorkload);
+BENCHMARK_TEMPLATE(BM_ArenaResource, ReservedVectorWorkload);
+BENCHMARK_TEMPLATE(BM_StackResource, ReservedVectorWorkload);
+
+BENCHMARK_TEMPLATE(BM_NewDeleteResource, ListWorkload);
+BENCHMARK_TEMPLATE(BM_MonotonicBufferResource, ListWorkload);
+BENCHMARK_TEMPLATE(BM_ArenaResource, ListWorkload);
+BENCHMARK_TEMPLATE(BM_BlockResource, ListWorkload);
+BENCHMARK_TEMPLATE(BM_BuddyResource, ListWorkload);
+BENCHMARK_TEMPLATE(BM_FreeListResource, ListWorkload, wmcv::FreeListFirstFitPolicy);
+BENCHMARK_TEMPLATE(BM_FreeListResource, ListWorkload, wmcv::FreeListBestFitPolicy);
+
+BENCHMARK_TEMPLATE(BM_NewDeleteResource, UnorderedMapWorkload);
+BENCHMARK_TEMPLATE(BM_MonotonicBufferResource, UnorderedMapWorkload);
+BENCHMARK_TEMPLATE(BM_ArenaResource, UnorderedMapWorkload);
+BENCHMARK_TEMPLATE(BM_BuddyResource, UnorderedMapWorkload);
+BENCHMARK_TEMPLATE(BM_FreeListResource, UnorderedMapWorkload, wmcv::FreeListFirstFitPolicy);
+BENCHMARK_TEMPLATE(BM_FreeListResource, UnorderedMapWorkload, wmcv::FreeListBestFitPolicy);
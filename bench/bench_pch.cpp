@@ -0,0 +1 @@
+#include "bench_pch.h"
\ No newline at end of file
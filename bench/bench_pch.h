@@ -0,0 +1,33 @@
+#ifndef WMCV_MEMORY_BENCH_PCH_H_INCLUDED
+#define WMCV_MEMORY_BENCH_PCH_H_INCLUDED
+
+#include <cinttypes>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+
+#include <type_traits>
+#include <concepts>
+#include <bit>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <memory_resource>
+#include <array>
+#include <span>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#endif //WMCV_MEMORY_BENCH_PCH_H_INCLUDED
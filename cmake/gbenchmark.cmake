@@ -0,0 +1,16 @@
+include_guard()
+
+CPMAddPackage(
+	NAME benchmark
+	GITHUB_REPOSITORY google/benchmark
+	GIT_TAG v1.8.0
+	VERSION 1.8.0
+	OPTIONS
+	"BENCHMARK_ENABLE_TESTING OFF"
+	"BENCHMARK_ENABLE_INSTALL OFF"
+	"BENCHMARK_ENABLE_GTEST_TESTS OFF"
+)
+set_property(TARGET 
+	benchmark 
+	benchmark_main
+	PROPERTY FOLDER third_party/GoogleBenchmark)
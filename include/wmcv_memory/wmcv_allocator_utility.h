@@ -4,6 +4,10 @@
 namespace wmcv
 {
 
+// Used to keep hot atomics away from data other threads read. Fixed rather than
+// std::hardware_destructive_interference_size so the layout is ABI stable
+inline constexpr size_t CacheLineSize = 64;
+
 [[nodiscard]] inline auto ptr_to_address(void* ptr) noexcept -> uintptr_t
 {
 	return reinterpret_cast<uintptr_t>(ptr);
@@ -35,6 +39,14 @@ namespace wmcv
 	return result;
 }
 
+// Strongest alignment shared by every chunk of a pool laid out at base + n * chunkSize,
+// the lowest set bit of either
+[[nodiscard]] constexpr auto chunk_alignment(uintptr_t baseAddress, size_t chunkSize) noexcept -> size_t
+{
+	const uintptr_t bits = baseAddress | uintptr_t{chunkSize};
+	return bits & (~bits + 1);
+}
+
 [[nodiscard]] inline auto is_ptr_aligned(void* ptr, size_t alignment) noexcept -> bool
 {
 	assert(is_power_of_two(alignment) && "Error: alignment isn't a power of 2");
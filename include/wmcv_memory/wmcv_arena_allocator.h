@@ -1,26 +1,76 @@
-#ifndef WMCV_ARENA_ALLOCATOR_H_INCLUDED
-#define WMCV_ARENA_ALLOCATOR_H_INCLUDED
-
-#include "wmcv_memory_block.h"
-
-namespace wmcv
-{
-	class ArenaAllocator
-	{
-	public:
-		ArenaAllocator(Block block) noexcept;
-
-		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
-		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block;
-
-		void free(void*) noexcept;
-		void reset() noexcept;
-
-	private:
-		uintptr_t m_baseAddress;
-		size_t m_size;
-		size_t m_marker;
-	};
-}
-
+#ifndef WMCV_ARENA_ALLOCATOR_H_INCLUDED
+#define WMCV_ARENA_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_arena_finalizer.h"
+
+namespace wmcv
+{
+	class ArenaAllocator
+	{
+	public:
+		using Marker = size_t;
+
+		ArenaAllocator(Block block) noexcept;
+		~ArenaAllocator() noexcept;
+
+		ArenaAllocator(const ArenaAllocator&) = delete;
+		ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
+		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block;
+
+		// Reserves count contiguous blocks with one marker bump and writes them to blocks.
+		// All or nothing, returns count or 0 if they don't all fit
+		[[nodiscard]] auto allocate_n(size_t count, size_t size, size_t alignment, std::span<Block> blocks) noexcept -> size_t;
+
+		// Constructs a T in the arena, nullptr if it doesn't fit. Types that aren't
+		// trivially destructible are destroyed in reverse order by reset, rewind
+		// and the arena's destructor
+		template<typename T, typename... Args>
+		[[nodiscard]] auto create(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> T*
+		{
+			const Block block = allocate_aligned(detail::arena_object_size<T>(), detail::arena_object_alignment<T>());
+			if (block == NullBlock())
+			{
+				return nullptr;
+			}
+
+			T* object = ::new (address_to_ptr(block.address + detail::arena_object_offset<T>())) T(std::forward<Args>(args)...);
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				push_finalizer(detail::make_arena_finalizer<T>(block.address));
+			}
+
+			return object;
+		}
+
+		// Resize the most recent allocation in place, NullBlock if block isn't the last allocation or won't fit.
+		// shrink runs the destructors of anything created in the range it releases
+		[[nodiscard]] auto try_expand(Block block, size_t new_size) noexcept -> Block;
+		[[nodiscard]] auto shrink(Block block, size_t new_size) noexcept -> Block;
+
+		// Resize in place where possible, otherwise allocate a new block and copy the contents across
+		[[nodiscard]] auto reallocate(Block block, size_t new_size) noexcept -> Block;
+		[[nodiscard]] auto reallocate_aligned(Block block, size_t new_size, size_t alignment) noexcept -> Block;
+
+		void free(void*) noexcept;
+		void reset() noexcept;
+
+		[[nodiscard]] auto get_marker() const noexcept -> Marker;
+		void rewind(Marker marker) noexcept;
+
+	private:
+		[[nodiscard]] auto is_last_allocation(Block block) const noexcept -> bool;
+
+		void push_finalizer(ArenaFinalizer* finalizer) noexcept;
+		void run_finalizers(Marker marker) noexcept;
+
+		uintptr_t m_baseAddress;
+		size_t m_size;
+		size_t m_marker;
+		ArenaFinalizer* m_finalizers;
+	};
+}
+
 #endif //WMCV_ARENA_ALLOCATOR_H_INCLUDED
\ No newline at end of file
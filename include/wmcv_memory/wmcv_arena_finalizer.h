@@ -0,0 +1,65 @@
+#ifndef WMCV_ARENA_FINALIZER_H_INCLUDED
+#define WMCV_ARENA_FINALIZER_H_INCLUDED
+
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+	// Intrusive node written in front of each object an arena creates that
+	// needs its destructor run. The object lives at a fixed offset after the
+	// node so the node only has to store how to destroy it.
+	struct ArenaFinalizer
+	{
+		ArenaFinalizer* next;
+		void (*destroy)(ArenaFinalizer*) noexcept;
+	};
+}
+
+namespace wmcv::detail
+{
+	template<typename T>
+	[[nodiscard]] constexpr auto arena_object_offset() noexcept -> size_t
+	{
+		if constexpr (std::is_trivially_destructible_v<T>)
+		{
+			return 0;
+		}
+		else
+		{
+			return align(sizeof(ArenaFinalizer), alignof(T));
+		}
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr auto arena_object_size() noexcept -> size_t
+	{
+		return arena_object_offset<T>() + sizeof(T);
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr auto arena_object_alignment() noexcept -> size_t
+	{
+		if constexpr (std::is_trivially_destructible_v<T>)
+		{
+			return alignof(T);
+		}
+		else
+		{
+			return std::max(alignof(ArenaFinalizer), alignof(T));
+		}
+	}
+
+	template<typename T>
+	void destroy_arena_object(ArenaFinalizer* finalizer) noexcept
+	{
+		static_cast<T*>(offset_ptr(finalizer, arena_object_offset<T>()))->~T();
+	}
+
+	template<typename T>
+	[[nodiscard]] auto make_arena_finalizer(uintptr_t address) noexcept -> ArenaFinalizer*
+	{
+		return ::new (address_to_ptr(address)) ArenaFinalizer{.next = nullptr, .destroy = &destroy_arena_object<T>};
+	}
+}
+
+#endif //WMCV_ARENA_FINALIZER_H_INCLUDED
@@ -0,0 +1,38 @@
+#ifndef WMCV_ARENA_SCOPE_H_INCLUDED
+#define WMCV_ARENA_SCOPE_H_INCLUDED
+
+namespace wmcv
+{
+	template<typename T>
+	concept MarkedArena = requires(T t, typename T::Marker marker) {
+		{ t.get_marker() } -> std::same_as<typename T::Marker>;
+		t.rewind(marker);
+	};
+
+	// Rewinds the arena to where it was when the scope was opened, releasing
+	// any scratch memory allocated inside the scope
+	template< MarkedArena Arena >
+	class ArenaScope
+	{
+	public:
+		explicit ArenaScope(Arena& arena) noexcept
+			: m_arena(arena)
+			, m_marker(arena.get_marker())
+		{
+		}
+
+		~ArenaScope() noexcept
+		{
+			m_arena.rewind(m_marker);
+		}
+
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+	private:
+		Arena& m_arena;
+		typename Arena::Marker m_marker;
+	};
+}
+
+#endif //WMCV_ARENA_SCOPE_H_INCLUDED
@@ -0,0 +1,72 @@
+#ifndef WMCV_BITMAP_BLOCK_ALLOCATOR_H_INCLUDED
+#define WMCV_BITMAP_BLOCK_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+
+namespace wmcv
+{
+	// Fixed size pool that tracks occupancy in a bitmap carved from the front of
+	// the block instead of threading a free list through the chunks, so allocate,
+	// free and reset only touch the bitmap and never the chunks themselves.
+	// Two more levels above it, each with one bit per word of the level below,
+	// mark the words that still have a free chunk under them, so finding the
+	// lowest free chunk is a ctz per level.
+	class BitmapBlockAllocator
+	{
+	public:
+		BitmapBlockAllocator(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept;
+
+		BitmapBlockAllocator(const BitmapBlockAllocator&) = delete;
+		BitmapBlockAllocator& operator=(const BitmapBlockAllocator&) = delete;
+
+		// Returns the lowest free chunk
+		[[nodiscard]] auto allocate() noexcept -> Block;
+
+		void free(void* ptr) noexcept;
+
+		// Clears the bitmap, O(chunk_count / 64)
+		void reset() noexcept;
+
+		// Calls func(Block) for every live chunk in address order
+		template<typename Func>
+		void for_each(Func&& func) const
+		{
+			for (size_t word = 0; word < m_wordCount; ++word)
+			{
+				uint64_t bits = m_bitmap[word] & live_mask(word);
+				while (bits != 0)
+				{
+					const size_t index = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+					func(Block{.address = m_baseAddress + index * m_chunkSize, .size = m_chunkSize});
+					bits &= bits - 1;
+				}
+			}
+		}
+
+		[[nodiscard]] auto chunk_size() const noexcept -> size_t;
+		[[nodiscard]] auto chunk_count() const noexcept -> size_t;
+		[[nodiscard]] auto live_count() const noexcept -> size_t;
+
+	private:
+		// Bits past chunk_count in the last word are kept set so the scan never
+		// hands them out, this masks them back off
+		[[nodiscard]] auto live_mask(size_t word) const noexcept -> uint64_t;
+
+		[[nodiscard]] auto owns_address(uintptr_t address) const noexcept -> bool;
+
+		uint64_t* m_bitmap;
+		uint64_t* m_summary;
+		uint64_t* m_top;
+		size_t m_wordCount;
+		size_t m_summaryCount;
+		size_t m_topCount;
+		uintptr_t m_baseAddress;
+		size_t m_chunkSize;
+		size_t m_chunkCount;
+
+		// No top word below this one has a bit set
+		size_t m_firstFreeTop;
+	};
+}
+
+#endif //WMCV_BITMAP_BLOCK_ALLOCATOR_H_INCLUDED
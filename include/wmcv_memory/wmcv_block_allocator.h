@@ -13,21 +13,47 @@ namespace wmcv
 	class BlockAllocator
 	{
 	public:
+		// Chunks are handed out in ascending address order after construction and
+		// reset, after that freed chunks are reused most recently freed first
 		BlockAllocator(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept;
 
 		[[nodiscard]] auto allocate() noexcept -> Block;
 
+		// Detaches up to count chunks from the free list in one go and writes them to blocks,
+		// returns how many were allocated
+		[[nodiscard]] auto allocate_n(size_t count, std::span<Block> blocks) noexcept -> size_t;
+
 		void free(void* ptr) noexcept;
+
+		// Sorts the free list by address so heavy churn doesn't leave allocation order
+		// scattered across the pool. O(n log n) in the number of free chunks, free
+		// never does this itself, call it at a quiet point such as between frames
+		void sort_free_list() noexcept;
+
+		// Frees since the last sort_free_list or reset, for deciding when to sort
+		[[nodiscard]] auto frees_since_sort() const noexcept -> size_t;
+
+		// O(1), chunks are carved lazily so reset doesn't touch the pool's memory
 		void reset() noexcept;
 
+		[[nodiscard]] auto chunk_size() const noexcept -> size_t;
+		[[nodiscard]] auto chunk_alignment() const noexcept -> size_t;
+
 	private:
 
 		[[nodiscard]] auto owns_address(uintptr_t address) const noexcept -> bool;
 
-		BlockFreeListNode* m_freeStore;
 		uintptr_t m_baseAddress;
 		size_t m_size;
 		size_t m_chunkSize;
+		size_t m_chunkCount;
+
+		// Chunks below this index have been handed out at least once, the ones
+		// above it have never been touched and aren't on the free list
+		size_t m_untouched;
+		BlockFreeListNode* m_freeStore;
+
+		size_t m_freesSinceSort;
 	};
 }
 
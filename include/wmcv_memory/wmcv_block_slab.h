@@ -0,0 +1,81 @@
+#ifndef WMCV_BLOCK_SLAB_H_INCLUDED
+#define WMCV_BLOCK_SLAB_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+#include "wmcv_block_allocator.h"
+
+namespace wmcv
+{
+	// Header at the start of every slab the slab pools carve into fixed size
+	// chunks, the slab's chunks follow it. Slabs are aligned to their size so a
+	// chunk's slab is found by masking the pointer
+	struct BlockSlab
+	{
+		BlockAllocator chunks;
+		BlockSlab* prev;
+		BlockSlab* next;
+
+		// SlabAllocator's size class, GrowingBlockAllocator leaves it at 0
+		size_t sizeClass;
+		size_t live;
+		size_t capacity;
+	};
+}
+
+namespace wmcv::detail
+{
+	[[nodiscard]] inline auto make_block_slab(Block slab, size_t chunkSize, size_t chunkAlignment, size_t sizeClass = 0) noexcept -> BlockSlab*
+	{
+		const Block chunks = {.address = slab.address + sizeof(BlockSlab), .size = slab.size - sizeof(BlockSlab)};
+		const uintptr_t chunksStart = align(chunks.address, chunkAlignment);
+
+		return ::new (address_to_ptr(slab.address)) BlockSlab
+		{
+			.chunks = BlockAllocator(chunks, chunkSize, chunkAlignment),
+			.prev = nullptr,
+			.next = nullptr,
+			.sizeClass = sizeClass,
+			.live = 0,
+			.capacity = (slab.address + slab.size - chunksStart) / align(chunkSize, chunkAlignment)
+		};
+	}
+
+	[[nodiscard]] inline auto slab_of(uintptr_t address, size_t slabSize) noexcept -> BlockSlab*
+	{
+		return static_cast<BlockSlab*>(address_to_ptr(address & ~(slabSize - 1)));
+	}
+
+	inline void link_slab(BlockSlab*& head, BlockSlab* slab) noexcept
+	{
+		slab->prev = nullptr;
+		slab->next = head;
+		if (head)
+		{
+			head->prev = slab;
+		}
+		head = slab;
+	}
+
+	inline void unlink_slab(BlockSlab*& head, BlockSlab* slab) noexcept
+	{
+		if (slab->prev)
+		{
+			slab->prev->next = slab->next;
+		}
+		else
+		{
+			head = slab->next;
+		}
+
+		if (slab->next)
+		{
+			slab->next->prev = slab->prev;
+		}
+
+		slab->prev = nullptr;
+		slab->next = nullptr;
+	}
+}
+
+#endif //WMCV_BLOCK_SLAB_H_INCLUDED
@@ -11,29 +11,82 @@ namespace wmcv
 		size_t free : 1;
 	};
 
+	// Free blocks are linked into the list for their order just after their
+	// header, or at their start without headers, by index in units of the
+	// allocator's alignment
+	struct BuddyFreeLinks
+	{
+		uint32_t prev;
+		uint32_t next;
+	};
+
+	// Free blocks of each order, from the alignment up to the whole block, are
+	// kept on their own list with a bit per order set while its list is non-empty,
+	// so allocation finds the smallest block that fits with a single bit scan.
+	// free merges a block with its buddy, found by flipping the order's bit in
+	// the block's offset, for as many orders as the buddies are free.
 	class BuddyAllocator
 	{
 	public:
 		BuddyAllocator(const Block block, size_t alignment = sizeof(BuddyBlock)) noexcept;
 
+		// Keeps each block's order and free bit in metadata, a byte per alignment
+		// sized unit of block, instead of a header in front of the payload. Payloads
+		// start on their block's boundary, so a power-of-two request takes a block
+		// of exactly its size, aligned to that size relative to block.address
+		BuddyAllocator(const Block block, Block metadata, size_t alignment = sizeof(BuddyBlock)) noexcept;
+
+		[[nodiscard]] static constexpr auto metadata_size(size_t size, size_t alignment = sizeof(BuddyBlock)) noexcept -> size_t
+		{
+			return size / std::max(alignment, sizeof(BuddyBlock));
+		}
+
 		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
 
 		void free(void* ptr) noexcept;
+
+		// Shrinks in place by splitting off the upper halves, grows in place when the
+		// buddies above the block are free, otherwise allocates a new block and copies
+		// the contents across. Returns NullBlock and leaves block alone if nothing fits
+		[[nodiscard]] auto reallocate(Block block, size_t new_size) noexcept -> Block;
+
 		void reset() noexcept;
 
+		[[nodiscard]] auto alignment() const noexcept -> size_t;
+
 	private:
 
+		static constexpr size_t s_max_orders = 64;
+
 		[[nodiscard]] auto owns_address(uintptr_t address) const noexcept -> bool;
-		[[nodiscard]] auto split_block(BuddyBlock* block, size_t size) noexcept -> BuddyBlock*;
-		[[nodiscard]] auto search_blocks(size_t size) noexcept -> BuddyBlock*;
-		void coalesce() noexcept;
+		[[nodiscard]] auto order_of(size_t size) const noexcept -> size_t;
+		[[nodiscard]] auto block_address(uint32_t index) const noexcept -> uintptr_t;
+		[[nodiscard]] auto index_of(uintptr_t address) const noexcept -> uint32_t;
+		[[nodiscard]] auto links(uint32_t index) const noexcept -> BuddyFreeLinks*;
+
+		// Block state, from the header in front of the block or the metadata byte for it
+		[[nodiscard]] auto is_free_block(uint32_t index, size_t order) const noexcept -> bool;
+		[[nodiscard]] auto block_order(uint32_t index) const noexcept -> size_t;
+		void write_block(uint32_t index, size_t order, bool free) noexcept;
+
+		// Pops the smallest free block of at least order and splits it down to order
+		[[nodiscard]] auto take_free_block(size_t order) noexcept -> uint32_t;
+
+		void push_free(uint32_t index, size_t order) noexcept;
+		void remove_free(uint32_t index, size_t order) noexcept;
 
 		uintptr_t m_baseAddress;
 		size_t m_size;
 		size_t m_alignment;
+		size_t m_alignmentShift;
+
+		// nullptr when blocks carry their own headers
+		uint8_t* m_metadata;
+		size_t m_headerSize;
 
-		BuddyBlock* m_head;
-		BuddyBlock* m_tail;
+		// Bit n is set while m_freeLists[n] isn't empty
+		size_t m_freeMask;
+		std::array<uint32_t, s_max_orders> m_freeLists;
 	};
 }
 
@@ -0,0 +1,158 @@
+#ifndef WMCV_CHAINED_ARENA_ALLOCATOR_H_INCLUDED
+#define WMCV_CHAINED_ARENA_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+#include "wmcv_upstream_allocator.h"
+
+namespace wmcv
+{
+	struct ArenaChunk
+	{
+		ArenaChunk* next;
+		size_t size;
+	};
+
+	// Arena that keeps bump allocating past the end of its block by pulling a
+	// new, geometrically larger chunk from the upstream allocator. Each chunk
+	// starts with an ArenaChunk header linking it to the previous one.
+	template< UpstreamAllocator Upstream >
+	class ChainedArenaAllocator
+	{
+	public:
+		ChainedArenaAllocator(Upstream& upstream, size_t initialChunkSize, size_t growthFactor = 2) noexcept
+			: m_upstream(&upstream)
+			, m_head(nullptr)
+			, m_baseAddress(0llu)
+			, m_size(0llu)
+			, m_marker(0llu)
+			, m_nextChunkSize(initialChunkSize)
+			, m_growthFactor(growthFactor)
+		{
+			assert(m_nextChunkSize > sizeof(ArenaChunk) && "Initial chunk size is too small");
+			assert(m_growthFactor >= 1 && "Growth factor must be at least 1");
+		}
+
+		~ChainedArenaAllocator() noexcept
+		{
+			release(nullptr);
+		}
+
+		ChainedArenaAllocator(const ChainedArenaAllocator&) = delete;
+		ChainedArenaAllocator& operator=(const ChainedArenaAllocator&) = delete;
+
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block
+		{
+			constexpr size_t s_default_alignment = 16;
+			return allocate_aligned(size, s_default_alignment);
+		}
+
+		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block
+		{
+			uintptr_t offset = align(m_baseAddress + m_marker, alignment) - m_baseAddress;
+
+			if (m_head == nullptr || offset + size > m_size)
+			{
+				if (!add_chunk(size, alignment))
+				{
+					return NullBlock();
+				}
+
+				offset = align(m_baseAddress + m_marker, alignment) - m_baseAddress;
+			}
+
+			const uintptr_t address = m_baseAddress + offset;
+			m_marker = offset + size;
+			return { .address = address, .size = size };
+		}
+
+		void free(void*) noexcept
+		{
+		}
+
+		// Keeps the largest chunk for reuse and hands the rest back upstream
+		void reset() noexcept
+		{
+			ArenaChunk* largest = m_head;
+			for (ArenaChunk* chunk = m_head; chunk != nullptr; chunk = chunk->next)
+			{
+				if (chunk->size > largest->size)
+				{
+					largest = chunk;
+				}
+			}
+
+			release(largest);
+
+			m_head = largest;
+			if (m_head)
+			{
+				m_head->next = nullptr;
+				m_baseAddress = ptr_to_address(m_head);
+				m_size = m_head->size;
+			}
+			m_marker = sizeof(ArenaChunk);
+		}
+
+		[[nodiscard]] auto chunk_count() const noexcept -> size_t
+		{
+			size_t count = 0;
+			for (const ArenaChunk* chunk = m_head; chunk != nullptr; chunk = chunk->next)
+			{
+				++count;
+			}
+			return count;
+		}
+
+	private:
+		auto add_chunk(size_t size, size_t alignment) noexcept -> bool
+		{
+			const size_t required = sizeof(ArenaChunk) + alignment + size;
+			const size_t chunk_size = std::max(m_nextChunkSize, required);
+
+			const Block block = m_upstream->allocate(chunk_size);
+			if (block == NullBlock())
+			{
+				return false;
+			}
+
+			assert(is_aligned(block.address, alignof(ArenaChunk)) && "Upstream returned a misaligned chunk");
+
+			const ArenaChunk chunkData = {.next = m_head, .size = chunk_size};
+			void* ptr = address_to_ptr(block.address);
+			std::memcpy(ptr, &chunkData, sizeof(ArenaChunk));
+
+			m_head = static_cast<ArenaChunk*>(ptr);
+			m_baseAddress = block.address;
+			m_size = chunk_size;
+			m_marker = sizeof(ArenaChunk);
+			m_nextChunkSize = chunk_size * m_growthFactor;
+			return true;
+		}
+
+		void release(ArenaChunk* keep) noexcept
+		{
+			ArenaChunk* chunk = m_head;
+			while (chunk != nullptr)
+			{
+				ArenaChunk* next = chunk->next;
+				if (chunk != keep)
+				{
+					m_upstream->free(chunk);
+				}
+				chunk = next;
+			}
+			m_head = nullptr;
+		}
+
+		Upstream* m_upstream;
+		ArenaChunk* m_head;
+		uintptr_t m_baseAddress;
+		size_t m_size;
+		size_t m_marker;
+		size_t m_nextChunkSize;
+		size_t m_growthFactor;
+	};
+}
+
+#endif //WMCV_CHAINED_ARENA_ALLOCATOR_H_INCLUDED
@@ -0,0 +1,83 @@
+#ifndef WMCV_CONCURRENT_BUDDY_ALLOCATOR_H_INCLUDED
+#define WMCV_CONCURRENT_BUDDY_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+#include "wmcv_buddy_allocator.h"
+
+namespace wmcv
+{
+	// Buddy allocator that's safe to allocate from and free to on any number of
+	// threads. Each order's free list has its own lock, on its own cache line,
+	// and a thread only ever holds one of them at a time: splitting pops a block
+	// under its order's lock then pushes each upper half under the lock for the
+	// half's order, merging removes the buddy under the current order's lock and
+	// carries the merged block up to the next. Threads working on different
+	// orders don't contend, and an atomic mask of the non-empty lists lets
+	// allocate skip orders without locking them.
+	//
+	// Block state lives out of band, a byte per alignment unit as in
+	// BuddyAllocator's metadata mode. A block is only marked free under the lock
+	// for its order and only stops being free under the same lock, which is what
+	// lets a free see a buddy that's being freed at the same time.
+	//
+	// A block is in no list while it's being split or merged, so when the heap
+	// is close to full allocate can fail while another thread has the only
+	// block that fits in hand.
+	class ConcurrentBuddyAllocator
+	{
+	public:
+		ConcurrentBuddyAllocator(const Block block, Block metadata, size_t alignment = sizeof(BuddyFreeLinks)) noexcept;
+
+		ConcurrentBuddyAllocator(const ConcurrentBuddyAllocator&) = delete;
+		ConcurrentBuddyAllocator& operator=(const ConcurrentBuddyAllocator&) = delete;
+
+		[[nodiscard]] static constexpr auto metadata_size(size_t size, size_t alignment = sizeof(BuddyFreeLinks)) noexcept -> size_t
+		{
+			return size / std::max(alignment, sizeof(BuddyFreeLinks));
+		}
+
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
+
+		void free(void* ptr) noexcept;
+
+		// Not safe while other threads are using the allocator
+		void reset() noexcept;
+
+		[[nodiscard]] auto alignment() const noexcept -> size_t;
+
+	private:
+
+		static constexpr size_t s_max_orders = 64;
+
+		struct alignas(CacheLineSize) FreeList
+		{
+			std::mutex lock;
+			uint32_t head;
+		};
+
+		[[nodiscard]] auto owns_address(uintptr_t address) const noexcept -> bool;
+		[[nodiscard]] auto order_of(size_t size) const noexcept -> size_t;
+		[[nodiscard]] auto block_address(uint32_t index) const noexcept -> uintptr_t;
+		[[nodiscard]] auto index_of(uintptr_t address) const noexcept -> uint32_t;
+		[[nodiscard]] auto links(uint32_t index) const noexcept -> BuddyFreeLinks*;
+
+		// Called with m_freeLists[order].lock held
+		[[nodiscard]] auto pop_free(size_t order) noexcept -> uint32_t;
+		void push_free(uint32_t index, size_t order) noexcept;
+		void remove_free(uint32_t index, size_t order) noexcept;
+
+		uintptr_t m_baseAddress;
+		size_t m_size;
+		size_t m_alignment;
+		size_t m_alignmentShift;
+		size_t m_maxOrder;
+		std::atomic_uint8_t* m_metadata;
+
+		// Bit n is set while m_freeLists[n] isn't empty, only changed under its lock
+		alignas(CacheLineSize) std::atomic_size_t m_freeMask;
+		std::array<FreeList, s_max_orders> m_freeLists;
+	};
+}
+
+#endif //WMCV_CONCURRENT_BUDDY_ALLOCATOR_H_INCLUDED
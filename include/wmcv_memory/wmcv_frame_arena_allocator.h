@@ -0,0 +1,138 @@
+#ifndef WMCV_FRAME_ARENA_ALLOCATOR_H_INCLUDED
+#define WMCV_FRAME_ARENA_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+#include "wmcv_arena_scope.h"
+
+namespace wmcv
+{
+	template<typename T>
+	concept FrameArena = MarkedArena<T> && std::constructible_from<T, Block> && requires(T t) {
+		{ t.allocate(size_t{}) } -> std::same_as<Block>;
+		{ t.allocate_aligned(size_t{}, size_t{}) } -> std::same_as<Block>;
+		t.reset();
+	};
+
+	// Splits one block into FrameCount arenas and allocates from a different one
+	// each frame. Memory allocated in a frame stays valid for FrameCount frames,
+	// advance_frame only resets the arena whose data has outlived that window.
+	//
+	// advance_frame must not race with allocations, with a LocklessArenaAllocator
+	// any number of threads may allocate within a frame.
+	template< FrameArena Arena, size_t FrameCount >
+	requires (FrameCount > 0)
+	class FrameArenaAllocator
+	{
+	public:
+		explicit FrameArenaAllocator(Block block) noexcept
+			: m_arenas(make_arenas(block, std::make_index_sequence<FrameCount>{}))
+			, m_highWater{}
+			, m_frameSize(frame_size(block))
+			, m_frame(0llu)
+		{
+		}
+
+		FrameArenaAllocator(const FrameArenaAllocator&) = delete;
+		FrameArenaAllocator& operator=(const FrameArenaAllocator&) = delete;
+
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block
+		{
+			return current().allocate(size);
+		}
+
+		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block
+		{
+			return current().allocate_aligned(size, alignment);
+		}
+
+		template<typename T, typename... Args>
+		[[nodiscard]] auto create(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> T*
+		{
+			return current().template create<T>(std::forward<Args>(args)...);
+		}
+
+		void free(void*) noexcept
+		{
+		}
+
+		// Moves to the next frame and resets the arena that was used FrameCount frames ago
+		void advance_frame() noexcept
+		{
+			++m_frame;
+
+			const size_t index = m_frame % FrameCount;
+			m_highWater[index] = std::max(m_highWater[index], m_arenas[index].get_marker());
+			m_arenas[index].reset();
+		}
+
+		void reset() noexcept
+		{
+			for (auto& arena : m_arenas)
+			{
+				arena.reset();
+			}
+		}
+
+		[[nodiscard]] auto frame() const noexcept -> size_t
+		{
+			return m_frame;
+		}
+
+		[[nodiscard]] auto frame_capacity() const noexcept -> size_t
+		{
+			return m_frameSize;
+		}
+
+		// Bytes allocated so far in the current frame
+		[[nodiscard]] auto used() const noexcept -> size_t
+		{
+			return m_arenas[m_frame % FrameCount].get_marker();
+		}
+
+		// Most bytes a single frame has used in the given buffer, for sizing the frames
+		[[nodiscard]] auto high_water_mark(size_t buffer) const noexcept -> size_t
+		{
+			assert(buffer < FrameCount && "Buffer index out of range");
+			return std::max(m_highWater[buffer], m_arenas[buffer].get_marker());
+		}
+
+		[[nodiscard]] auto high_water_mark() const noexcept -> size_t
+		{
+			size_t result = 0;
+			for (size_t buffer = 0; buffer < FrameCount; ++buffer)
+			{
+				result = std::max(result, high_water_mark(buffer));
+			}
+			return result;
+		}
+
+	private:
+		static constexpr size_t s_frame_alignment = 16;
+
+		[[nodiscard]] static auto frame_size(Block block) noexcept -> size_t
+		{
+			// round down so every frame starts on the same alignment as the block
+			return (block.size / FrameCount) & ~(s_frame_alignment - 1);
+		}
+
+		template<size_t... Indices>
+		[[nodiscard]] static auto make_arenas(Block block, std::index_sequence<Indices...>) noexcept -> std::array<Arena, FrameCount>
+		{
+			const size_t size = frame_size(block);
+			return { Arena(Block{ .address = block.address + Indices * size, .size = size })... };
+		}
+
+		[[nodiscard]] auto current() noexcept -> Arena&
+		{
+			return m_arenas[m_frame % FrameCount];
+		}
+
+		std::array<Arena, FrameCount> m_arenas;
+		std::array<size_t, FrameCount> m_highWater;
+		size_t m_frameSize;
+		size_t m_frame;
+	};
+}
+
+#endif //WMCV_FRAME_ARENA_ALLOCATOR_H_INCLUDED
@@ -24,12 +24,12 @@ namespace wmcv
 
 		[[nodiscard]] auto allocate(size_t size) noexcept -> Block 
 		{
-			m_policy.allocate(size);
+			return m_policy.allocate(size);
 		}
 
 		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block
 		{
-			m_policy.allocate_aligned(size, alignment);
+			return m_policy.allocate_aligned(size, alignment);
 		}
 
 		void free(void* ptr) noexcept
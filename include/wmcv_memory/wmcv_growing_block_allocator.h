@@ -0,0 +1,238 @@
+#ifndef WMCV_GROWING_BLOCK_ALLOCATOR_H_INCLUDED
+#define WMCV_GROWING_BLOCK_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+#include "wmcv_upstream_allocator.h"
+#include "wmcv_block_slab.h"
+
+namespace wmcv
+{
+	// Fixed size pool that grows by pulling slabs from the upstream allocator when
+	// it runs out and hands empty slabs back once more than retainedSlabs of them
+	// are sitting idle. Allocation stays in one slab until it fills up, then moves
+	// to the fullest partially used slab so lightly used slabs get the chance to
+	// drain and be returned.
+	//
+	// Slabs are aligned to their size so free finds a chunk's slab by masking the pointer.
+	template< AlignedUpstreamAllocator Upstream >
+	class GrowingBlockAllocator
+	{
+	public:
+		static constexpr size_t DefaultSlabSize = 64 * 1024;
+		static constexpr size_t DefaultRetainedSlabs = 1;
+
+		GrowingBlockAllocator(Upstream& upstream, size_t chunkSize, size_t chunkAlignment, size_t slabSize = DefaultSlabSize, size_t retainedSlabs = DefaultRetainedSlabs) noexcept
+			: m_upstream(&upstream)
+			, m_chunkSize(chunkSize)
+			, m_chunkAlignment(chunkAlignment)
+			, m_slabSize(slabSize)
+			, m_retainedSlabs(retainedSlabs)
+			, m_current(nullptr)
+			, m_partial(nullptr)
+			, m_full(nullptr)
+			, m_empty(nullptr)
+			, m_emptyCount(0)
+			, m_slabCount(0)
+		{
+			assert(is_power_of_two(m_slabSize) && "Slab size must be a power of two");
+			assert(align(sizeof(BlockSlab), m_chunkAlignment) + align(m_chunkSize, m_chunkAlignment) <= m_slabSize && "Slab size is too small to hold a chunk");
+		}
+
+		~GrowingBlockAllocator() noexcept
+		{
+			m_retainedSlabs = 0;
+			reset();
+		}
+
+		GrowingBlockAllocator(const GrowingBlockAllocator&) = delete;
+		GrowingBlockAllocator& operator=(const GrowingBlockAllocator&) = delete;
+
+		[[nodiscard]] auto allocate() noexcept -> Block
+		{
+			if (m_current == nullptr || m_current->live == m_current->capacity)
+			{
+				if (!next_slab())
+				{
+					return NullBlock();
+				}
+			}
+
+			++m_current->live;
+			return m_current->chunks.allocate();
+		}
+
+		void free(void* ptr) noexcept
+		{
+			if (ptr == nullptr)
+			{
+				return;
+			}
+
+			BlockSlab* slab = slab_of(ptr);
+			assert(slab->live > 0 && "Freeing to a slab with no live chunks");
+
+			slab->chunks.free(ptr);
+			const bool wasFull = slab->live-- == slab->capacity;
+
+			if (slab == m_current)
+			{
+				return;
+			}
+
+			if (wasFull)
+			{
+				detail::unlink_slab(m_full, slab);
+			}
+
+			if (slab->live == 0)
+			{
+				if (!wasFull)
+				{
+					detail::unlink_slab(m_partial, slab);
+				}
+				retire(slab);
+			}
+			else if (wasFull)
+			{
+				detail::link_slab(m_partial, slab);
+			}
+		}
+
+		// Frees every chunk, keeps up to retainedSlabs slabs and returns the rest upstream
+		void reset() noexcept
+		{
+			if (m_current)
+			{
+				retire(std::exchange(m_current, nullptr));
+			}
+
+			for (BlockSlab** list : {&m_partial, &m_full})
+			{
+				while (*list)
+				{
+					BlockSlab* slab = *list;
+					detail::unlink_slab(*list, slab);
+					retire(slab);
+				}
+			}
+
+			while (m_emptyCount > m_retainedSlabs)
+			{
+				BlockSlab* slab = m_empty;
+				detail::unlink_slab(m_empty, slab);
+				--m_emptyCount;
+				release(slab);
+			}
+		}
+
+		[[nodiscard]] auto chunk_size() const noexcept -> size_t
+		{
+			return align(m_chunkSize, m_chunkAlignment);
+		}
+
+		// Slabs currently held from upstream, including the empty ones being retained
+		[[nodiscard]] auto slab_count() const noexcept -> size_t
+		{
+			return m_slabCount;
+		}
+
+	private:
+		[[nodiscard]] auto slab_of(void* ptr) const noexcept -> BlockSlab*
+		{
+			return detail::slab_of(ptr_to_address(ptr), m_slabSize);
+		}
+
+		// Swaps the full current slab for the fullest partial slab, then a retained
+		// empty one, and only then asks upstream for a new one
+		auto next_slab() noexcept -> bool
+		{
+			BlockSlab* slab = m_partial;
+			for (BlockSlab* candidate = m_partial; candidate != nullptr; candidate = candidate->next)
+			{
+				if (candidate->live > slab->live)
+				{
+					slab = candidate;
+				}
+			}
+
+			if (slab)
+			{
+				detail::unlink_slab(m_partial, slab);
+			}
+			else if (m_empty)
+			{
+				slab = m_empty;
+				detail::unlink_slab(m_empty, slab);
+				--m_emptyCount;
+			}
+			else
+			{
+				slab = acquire();
+				if (slab == nullptr)
+				{
+					return false;
+				}
+			}
+
+			if (m_current)
+			{
+				detail::link_slab(m_full, m_current);
+			}
+			m_current = slab;
+			return true;
+		}
+
+		[[nodiscard]] auto acquire() noexcept -> BlockSlab*
+		{
+			const Block block = m_upstream->allocate_aligned(m_slabSize, m_slabSize);
+			if (block == NullBlock())
+			{
+				return nullptr;
+			}
+
+			assert(is_aligned(block.address, m_slabSize) && "Upstream returned a misaligned slab");
+
+			++m_slabCount;
+			return detail::make_block_slab({.address = block.address, .size = m_slabSize}, m_chunkSize, m_chunkAlignment);
+		}
+
+		// Keeps an empty slab for reuse while under the retention limit, otherwise returns it upstream
+		void retire(BlockSlab* slab) noexcept
+		{
+			if (m_emptyCount < m_retainedSlabs)
+			{
+				slab->live = 0;
+				slab->chunks.reset();
+				detail::link_slab(m_empty, slab);
+				++m_emptyCount;
+			}
+			else
+			{
+				release(slab);
+			}
+		}
+
+		void release(BlockSlab* slab) noexcept
+		{
+			--m_slabCount;
+			m_upstream->free(slab);
+		}
+
+		Upstream* m_upstream;
+		size_t m_chunkSize;
+		size_t m_chunkAlignment;
+		size_t m_slabSize;
+		size_t m_retainedSlabs;
+
+		// The slab allocations come from, it isn't on any of the lists
+		BlockSlab* m_current;
+		BlockSlab* m_partial;
+		BlockSlab* m_full;
+		BlockSlab* m_empty;
+		size_t m_emptyCount;
+		size_t m_slabCount;
+	};
+}
+
+#endif //WMCV_GROWING_BLOCK_ALLOCATOR_H_INCLUDED
@@ -2,24 +2,80 @@
 #define WMCV_LOCKLESS_ARENA_ALLOCATOR_H_INCLUDED
 
 #include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+#include "wmcv_arena_finalizer.h"
 
 namespace wmcv
 {
 class LocklessArenaAllocator
 {
 public:
-	LocklessArenaAllocator(Block block) noexcept;
+	using Marker = size_t;
+
+	static constexpr size_t DefaultGranule = 16;
+
+	// Requests aligned to at most the granule take a wait-free fetch_add path and
+	// are rounded up to a multiple of the granule, larger alignments use a CAS loop
+	LocklessArenaAllocator(Block block, size_t granule = DefaultGranule) noexcept;
+	~LocklessArenaAllocator() noexcept;
+
+	LocklessArenaAllocator(const LocklessArenaAllocator&) = delete;
+	LocklessArenaAllocator& operator=(const LocklessArenaAllocator&) = delete;
 
 	[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
 	[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block;
 
+	// Reserves count contiguous blocks with one atomic op and writes them to blocks.
+	// All or nothing, returns count or 0 if they don't all fit
+	[[nodiscard]] auto allocate_n(size_t count, size_t size, size_t alignment, std::span<Block> blocks) noexcept -> size_t;
+
+	// Constructs a T in the arena, nullptr if it doesn't fit. Safe to call from
+	// any thread, types that aren't trivially destructible are destroyed by
+	// reset, rewind and the arena's destructor
+	template<typename T, typename... Args>
+	[[nodiscard]] auto create(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> T*
+	{
+		const Block block = allocate_aligned(detail::arena_object_size<T>(), detail::arena_object_alignment<T>());
+		if (block == NullBlock())
+		{
+			return nullptr;
+		}
+
+		T* object = ::new (address_to_ptr(block.address + detail::arena_object_offset<T>())) T(std::forward<Args>(args)...);
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			push_finalizer(detail::make_arena_finalizer<T>(block.address));
+		}
+
+		return object;
+	}
+
 	void free(void*) noexcept;
 	void reset() noexcept;
 
+	[[nodiscard]] auto get_marker() const noexcept -> Marker;
+
+	// Only safe from the owning thread while no other thread is allocating
+	void rewind(Marker marker) noexcept;
+
+	// Incremented by every reset so ThreadLocalArenaBuffers know to drop their buffers
+	[[nodiscard]] auto epoch() const noexcept -> size_t;
+
+	[[nodiscard]] auto granule() const noexcept -> size_t;
+
 private:
+	[[nodiscard]] auto allocate_contended(size_t size, size_t alignment) noexcept -> Block;
+
+	void push_finalizer(ArenaFinalizer* finalizer) noexcept;
+	void run_finalizers(Marker marker) noexcept;
+
 	uintptr_t m_baseAddress;
 	size_t m_size;
-	std::atomic_size_t m_marker;
+	size_t m_granule;
+	std::atomic_size_t m_epoch;
+
+	alignas(CacheLineSize) std::atomic_size_t m_marker;
+	std::atomic<ArenaFinalizer*> m_finalizers;
 };
 } // namespace wmcv
 
@@ -2,14 +2,16 @@
 #define WMCV_LOCKLESS_BLOCK_ALLOCATOR_H_INCLUDED
 
 #include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
 
 namespace wmcv
 {
-	struct BlockFreeListNode
-	{
-		BlockFreeListNode* next;
-	};
-
+	// Lock-free pool of fixed size chunks, safe to allocate from and free to on
+	// any number of threads. The free list head is a 32-bit chunk index packed
+	// with a 32-bit version that changes on every push and pop, so a thread that
+	// stalls between reading the head and its CAS can't be fooled by the same
+	// chunk being popped and pushed back (ABA). Free chunks store the index of
+	// the next free chunk in their first four bytes.
 	class LocklessBlockAllocator
 	{
 	public:
@@ -17,17 +19,48 @@ namespace wmcv
 
 		[[nodiscard]] auto allocate() noexcept -> Block;
 
+		// Detaches up to count chunks from the free list in one go and writes them to blocks,
+		// returns how many were allocated
+		[[nodiscard]] auto allocate_n(size_t count, std::span<Block> blocks) noexcept -> size_t;
+
 		void free(void* ptr) noexcept;
+
+		// Frees every chunk in ptrs with a single update of the shared head
+		void free_batch(std::span<void* const> ptrs) noexcept;
+
+		// Links ptr to next in the pool's free list format, for building chains to free_chain
+		void chain(void* ptr, void* next) noexcept;
+
+		// Pushes a chain built with chain, first through last inclusive, with one CAS
+		void free_chain(void* first, void* last) noexcept;
+
+		// O(1), chunks are carved lazily so reset doesn't touch the pool's memory.
+		// Not safe while other threads are using the pool
 		void reset() noexcept;
 
+		[[nodiscard]] auto chunk_size() const noexcept -> size_t;
+		[[nodiscard]] auto chunk_alignment() const noexcept -> size_t;
+
 	private:
 
 		[[nodiscard]] auto owns_address(uintptr_t address) const noexcept -> bool;
+		[[nodiscard]] auto chunk_index(uintptr_t address) const noexcept -> uint32_t;
+		[[nodiscard]] auto chunk_address(uint32_t index) const noexcept -> uintptr_t;
+		[[nodiscard]] auto next_index(uint32_t index) const noexcept -> uint32_t;
+		[[nodiscard]] auto allocate_untouched(size_t count, std::span<Block> blocks) noexcept -> size_t;
 
-		std::atomic<BlockFreeListNode*> m_freeStore;
 		uintptr_t m_baseAddress;
 		size_t m_size;
 		size_t m_chunkSize;
+		size_t m_chunkCount;
+
+		// Chunks below this index have been handed out at least once, the ones
+		// above it have never been touched and aren't on the free list. Can run
+		// past m_chunkCount when threads race for the last chunks
+		alignas(CacheLineSize) std::atomic_size_t m_untouched;
+
+		// version << 32 | chunk index
+		alignas(CacheLineSize) std::atomic_uint64_t m_freeStore;
 	};
 }
 
@@ -0,0 +1,92 @@
+#ifndef WMCV_MAGAZINE_ALLOCATOR_H_INCLUDED
+#define WMCV_MAGAZINE_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+
+namespace wmcv
+{
+	class LocklessBlockAllocator;
+
+	// Free chunks held by a magazine are linked through their first word, the
+	// first chunk of a full magazine in the depot links to the next magazine
+	struct MagazineChunk
+	{
+		MagazineChunk* next;
+		MagazineChunk* nextMagazine;
+	};
+
+	struct Magazine
+	{
+		MagazineChunk* head;
+		size_t count;
+	};
+
+	// Shared store of full magazines sitting between the MagazineCaches and
+	// the LocklessBlockAllocator they draw from. Caches swap whole magazines
+	// with the depot so the lock is only taken once every magazineSize
+	// allocations or frees. Anything left in the depot goes back to the pool
+	// when the depot is destroyed.
+	class MagazineDepot
+	{
+	public:
+		static constexpr size_t DefaultMagazineSize = 32;
+
+		MagazineDepot(LocklessBlockAllocator& pool, size_t magazineSize = DefaultMagazineSize) noexcept;
+		~MagazineDepot() noexcept;
+
+		MagazineDepot(const MagazineDepot&) = delete;
+		MagazineDepot& operator=(const MagazineDepot&) = delete;
+
+		// A full magazine from the depot, or one filled straight from the pool.
+		// Empty if the pool is exhausted, it may be partly filled near the end
+		[[nodiscard]] auto acquire() noexcept -> Magazine;
+
+		// Full magazines are kept for other threads, partial ones go back to the pool
+		void release(Magazine magazine) noexcept;
+
+		[[nodiscard]] auto pool() const noexcept -> LocklessBlockAllocator&;
+		[[nodiscard]] auto magazine_size() const noexcept -> size_t;
+		[[nodiscard]] auto full_magazines() const noexcept -> size_t;
+
+	private:
+		void free_to_pool(Magazine magazine) noexcept;
+
+		LocklessBlockAllocator& m_pool;
+		size_t m_magazineSize;
+
+		mutable std::mutex m_lock;
+		MagazineChunk* m_full;
+		size_t m_fullCount;
+	};
+
+	// Per-thread front end over a MagazineDepot, a cache must only be used by
+	// one thread. It keeps a loaded and a previous magazine (Bonwick) so a
+	// thread that alternates allocating and freeing around a magazine boundary
+	// doesn't bounce magazines back and forth with the depot. Cached chunks are
+	// handed back to the depot when the cache is destroyed.
+	class MagazineCache
+	{
+	public:
+		explicit MagazineCache(MagazineDepot& depot) noexcept;
+		~MagazineCache() noexcept;
+
+		MagazineCache(const MagazineCache&) = delete;
+		MagazineCache& operator=(const MagazineCache&) = delete;
+
+		[[nodiscard]] auto allocate() noexcept -> Block;
+		void free(void* ptr) noexcept;
+
+		// Hands every cached chunk back to the depot
+		void flush() noexcept;
+
+		[[nodiscard]] auto cached() const noexcept -> size_t;
+
+	private:
+		MagazineDepot& m_depot;
+		size_t m_chunkSize;
+		Magazine m_loaded;
+		Magazine m_previous;
+	};
+}
+
+#endif //WMCV_MAGAZINE_ALLOCATOR_H_INCLUDED
@@ -0,0 +1,108 @@
+#ifndef WMCV_MEMORY_RESOURCE_H_INCLUDED
+#define WMCV_MEMORY_RESOURCE_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+	// Arenas, stack, freelist, system
+	template<typename T>
+	concept AlignedResourceAllocator = requires(T t, void* ptr) {
+		{ t.allocate_aligned(size_t{}, size_t{}) } -> std::same_as<Block>;
+		t.free(ptr);
+	};
+
+	// Block pools
+	template<typename T>
+	concept ChunkResourceAllocator = requires(T t, const T& ct, void* ptr) {
+		{ t.allocate() } -> std::same_as<Block>;
+		{ ct.chunk_size() } -> std::same_as<size_t>;
+		{ ct.chunk_alignment() } -> std::same_as<size_t>;
+		t.free(ptr);
+	};
+
+	// Buddy
+	template<typename T>
+	concept SizedResourceAllocator = requires(T t, const T& ct, void* ptr) {
+		{ t.allocate(size_t{}) } -> std::same_as<Block>;
+		{ ct.alignment() } -> std::same_as<size_t>;
+		t.free(ptr);
+	};
+
+	// Exposes a wmcv allocator as a std::pmr::memory_resource so pmr containers
+	// can allocate from it. The adapter does not own the allocator and two
+	// adapters compare equal when they wrap the same allocator instance.
+	//
+	// Requests the allocator cannot satisfy, including sizes or alignments a
+	// block pool or buddy allocator can't serve, throw std::bad_alloc as the
+	// memory_resource contract requires. The allocator's own freeing rules
+	// still apply, e.g. a StackAllocator must be released in LIFO order.
+	template< typename Allocator >
+	requires AlignedResourceAllocator<Allocator> || ChunkResourceAllocator<Allocator> || SizedResourceAllocator<Allocator>
+	class MemoryResourceAdapter : public std::pmr::memory_resource
+	{
+	public:
+		explicit MemoryResourceAdapter(Allocator& allocator) noexcept
+			: m_allocator(&allocator)
+		{
+		}
+
+		[[nodiscard]] auto allocator() const noexcept -> Allocator&
+		{
+			return *m_allocator;
+		}
+
+	private:
+		auto do_allocate(size_t bytes, size_t alignment) -> void* override
+		{
+			Block block = NullBlock();
+
+			if constexpr (AlignedResourceAllocator<Allocator>)
+			{
+				block = m_allocator->allocate_aligned(bytes, alignment);
+			}
+			else if constexpr (ChunkResourceAllocator<Allocator>)
+			{
+				if (bytes <= m_allocator->chunk_size() && alignment <= m_allocator->chunk_alignment())
+				{
+					block = m_allocator->allocate();
+				}
+			}
+			else
+			{
+				if (alignment <= m_allocator->alignment())
+				{
+					block = m_allocator->allocate(bytes);
+				}
+			}
+
+			if (block == NullBlock())
+			{
+				throw std::bad_alloc();
+			}
+
+			return address_to_ptr(block.address);
+		}
+
+		void do_deallocate(void* ptr, size_t, size_t) override
+		{
+			m_allocator->free(ptr);
+		}
+
+		[[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+		{
+			if (this == &other)
+			{
+				return true;
+			}
+
+			const auto* that = dynamic_cast<const MemoryResourceAdapter*>(&other);
+			return that != nullptr && that->m_allocator == m_allocator;
+		}
+
+		Allocator* m_allocator;
+	};
+}
+
+#endif //WMCV_MEMORY_RESOURCE_H_INCLUDED
@@ -0,0 +1,226 @@
+#ifndef WMCV_OBJECT_POOL_H_INCLUDED
+#define WMCV_OBJECT_POOL_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+	// 20 bit slot index and 12 bit generation packed into 32 bits
+	struct ObjectHandle
+	{
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t IndexMask = (uint32_t{1} << IndexBits) - 1;
+		static constexpr uint32_t GenerationMask = ~uint32_t{0} >> IndexBits;
+
+		[[nodiscard]] constexpr auto index() const noexcept -> uint32_t { return value & IndexMask; }
+		[[nodiscard]] constexpr auto generation() const noexcept -> uint32_t { return value >> IndexBits; }
+
+		constexpr bool operator==(const ObjectHandle&) const = default;
+
+		uint32_t value;
+	};
+
+	[[nodiscard]] constexpr auto NullHandle() noexcept -> ObjectHandle
+	{
+		return {.value = ~uint32_t{0}};
+	}
+
+	// Pool of T addressed by generational handles instead of pointers. Objects are
+	// kept packed at the front of the pool's storage so objects() can be walked
+	// sequentially, destroy moves the last object into the hole. A slot table maps
+	// handles to where their object currently lives and bumps the slot's generation
+	// when the object is destroyed, so stale handles resolve to nullptr until the
+	// 12 bit generation wraps.
+	//
+	// Pointers returned by get are invalidated by destroy, hold on to the handle.
+	template<typename T>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	class ObjectPool
+	{
+	public:
+		// The highest index is reserved for NullHandle
+		static constexpr size_t MaxCapacity = ObjectHandle::IndexMask;
+
+		explicit ObjectPool(Block block) noexcept
+			: m_slots(static_cast<Slot*>(address_to_ptr(align(block.address, alignof(Slot)))))
+			, m_denseToSlot(nullptr)
+			, m_objects(nullptr)
+			, m_capacity(compute_capacity(block))
+			, m_size(0)
+			, m_untouched(0)
+			, m_freeSlot(s_invalid_index)
+		{
+			assert(m_capacity > 0 && "Memory in block is too small to hold an object");
+
+			m_denseToSlot = reinterpret_cast<uint32_t*>(m_slots + m_capacity);
+			m_objects = static_cast<T*>(address_to_ptr(align(ptr_to_address(m_denseToSlot + m_capacity), alignof(T))));
+		}
+
+		~ObjectPool() noexcept
+		{
+			clear();
+		}
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		// NullHandle if the pool is full
+		template<typename... Args>
+		[[nodiscard]] auto create(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> ObjectHandle
+		{
+			if (m_size == m_capacity)
+			{
+				return NullHandle();
+			}
+
+			const uint32_t dense = static_cast<uint32_t>(m_size);
+			::new (static_cast<void*>(m_objects + dense)) T(std::forward<Args>(args)...);
+
+			uint32_t index = m_freeSlot;
+			if (index != s_invalid_index)
+			{
+				m_freeSlot = m_slots[index].dense;
+			}
+			else
+			{
+				index = static_cast<uint32_t>(m_untouched++);
+				m_slots[index].generation = 0;
+			}
+
+			m_slots[index].dense = dense;
+			m_denseToSlot[dense] = index;
+			++m_size;
+
+			return {.value = (m_slots[index].generation << ObjectHandle::IndexBits) | index};
+		}
+
+		void destroy(ObjectHandle handle) noexcept
+		{
+			if (!contains(handle))
+			{
+				assert(handle == NullHandle() && "Destroying a stale handle");
+				return;
+			}
+
+			Slot& slot = m_slots[handle.index()];
+			const uint32_t hole = slot.dense;
+			const uint32_t last = static_cast<uint32_t>(--m_size);
+
+			m_objects[hole].~T();
+			if (hole != last)
+			{
+				::new (static_cast<void*>(m_objects + hole)) T(std::move(m_objects[last]));
+				m_objects[last].~T();
+
+				m_denseToSlot[hole] = m_denseToSlot[last];
+				m_slots[m_denseToSlot[hole]].dense = hole;
+			}
+
+			slot.generation = (slot.generation + 1) & ObjectHandle::GenerationMask;
+			slot.dense = m_freeSlot;
+			m_freeSlot = handle.index();
+		}
+
+		// nullptr if the handle's object has been destroyed
+		[[nodiscard]] auto get(ObjectHandle handle) noexcept -> T*
+		{
+			return contains(handle) ? m_objects + m_slots[handle.index()].dense : nullptr;
+		}
+
+		[[nodiscard]] auto get(ObjectHandle handle) const noexcept -> const T*
+		{
+			return contains(handle) ? m_objects + m_slots[handle.index()].dense : nullptr;
+		}
+
+		[[nodiscard]] auto contains(ObjectHandle handle) const noexcept -> bool
+		{
+			// free slots keep their bumped generation, slots past m_untouched have never
+			// handed out a handle so only the bounds check is needed for those
+			return handle.index() < m_untouched && m_slots[handle.index()].generation == handle.generation();
+		}
+
+		// Live objects, packed, in no particular order
+		[[nodiscard]] auto objects() noexcept -> std::span<T>
+		{
+			return {m_objects, m_size};
+		}
+
+		[[nodiscard]] auto objects() const noexcept -> std::span<const T>
+		{
+			return {m_objects, m_size};
+		}
+
+		// Handle of the object at objects()[position]
+		[[nodiscard]] auto handle_at(size_t position) const noexcept -> ObjectHandle
+		{
+			assert(position < m_size && "Position out of range");
+			const uint32_t index = m_denseToSlot[position];
+			return {.value = (m_slots[index].generation << ObjectHandle::IndexBits) | index};
+		}
+
+		// Destroys every object, outstanding handles all become stale
+		void clear() noexcept
+		{
+			while (m_size > 0)
+			{
+				destroy(handle_at(m_size - 1));
+			}
+		}
+
+		[[nodiscard]] auto size() const noexcept -> size_t
+		{
+			return m_size;
+		}
+
+		[[nodiscard]] auto capacity() const noexcept -> size_t
+		{
+			return m_capacity;
+		}
+
+	private:
+		static constexpr uint32_t s_invalid_index = ObjectHandle::IndexMask;
+
+		// dense is the object's position while the slot is live, the next free slot otherwise
+		struct Slot
+		{
+			uint32_t generation;
+			uint32_t dense;
+		};
+
+		[[nodiscard]] static constexpr auto compute_capacity(Block block) noexcept -> size_t
+		{
+			const uintptr_t start = align(block.address, alignof(Slot));
+			const uintptr_t end = block.address + block.size;
+			if (start >= end)
+			{
+				return 0;
+			}
+
+			const auto fits = [=](size_t count)
+			{
+				const uintptr_t objects = align(start + count * (sizeof(Slot) + sizeof(uint32_t)), alignof(T));
+				return objects + count * sizeof(T) <= end;
+			};
+
+			size_t count = std::min((end - start) / (sizeof(Slot) + sizeof(uint32_t) + sizeof(T)), MaxCapacity);
+			while (count > 0 && !fits(count))
+			{
+				--count;
+			}
+			return count;
+		}
+
+		Slot* m_slots;
+		uint32_t* m_denseToSlot;
+		T* m_objects;
+		size_t m_capacity;
+		size_t m_size;
+
+		// Slots at and above this index have never been used
+		size_t m_untouched;
+		uint32_t m_freeSlot;
+	};
+}
+
+#endif //WMCV_OBJECT_POOL_H_INCLUDED
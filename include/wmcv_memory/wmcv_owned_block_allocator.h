@@ -0,0 +1,109 @@
+#ifndef WMCV_OWNED_BLOCK_ALLOCATOR_H_INCLUDED
+#define WMCV_OWNED_BLOCK_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_allocator_utility.h"
+#include "wmcv_block_allocator.h"
+
+namespace wmcv
+{
+	// Fixed size pool owned by a single thread. The owner allocates and frees
+	// through a plain BlockAllocator, other threads' frees are pushed onto a
+	// lock-free stack that the owner takes in one exchange the next time its
+	// own free list runs dry.
+	class OwnedBlockAllocator
+	{
+	public:
+		// The constructing thread is the owner until another thread calls claim
+		OwnedBlockAllocator(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept;
+
+		OwnedBlockAllocator(const OwnedBlockAllocator&) = delete;
+		OwnedBlockAllocator& operator=(const OwnedBlockAllocator&) = delete;
+
+		// Owner thread only
+		[[nodiscard]] auto allocate() noexcept -> Block;
+
+		// Any thread
+		void free(void* ptr) noexcept;
+
+		// Moves remotely freed chunks onto the owner's free list, returns how many
+		// there were. Owner thread only, allocate calls it when it runs out
+		auto drain_remote_frees() noexcept -> size_t;
+
+		// Makes the calling thread the owner. Safe while other threads free, they see
+		// either the old owner or the new one and push remotely either way. The
+		// previous owner must have stopped allocating and freeing before the claim
+		void claim() noexcept;
+
+		[[nodiscard]] auto owns(void* ptr) const noexcept -> bool;
+		[[nodiscard]] auto chunk_size() const noexcept -> size_t;
+
+	private:
+		BlockAllocator m_local;
+		uintptr_t m_baseAddress;
+		size_t m_size;
+		std::atomic<std::thread::id> m_owner;
+
+		alignas(CacheLineSize) std::atomic<BlockFreeListNode*> m_remoteFree;
+	};
+
+	// Splits one block into PoolCount owned pools, one per thread. free works
+	// out which pool a chunk came from by its address, so any thread can free
+	// any chunk without keeping track of where it was allocated.
+	template< size_t PoolCount >
+	requires (PoolCount > 0)
+	class OwnedBlockAllocatorGroup
+	{
+	public:
+		OwnedBlockAllocatorGroup(Block block, size_t chunkSize, size_t chunkAlignment) noexcept
+			: m_pools(make_pools(block, chunkSize, chunkAlignment, std::make_index_sequence<PoolCount>{}))
+			, m_baseAddress(block.address)
+			, m_poolSize(pool_size(block))
+		{
+		}
+
+		OwnedBlockAllocatorGroup(const OwnedBlockAllocatorGroup&) = delete;
+		OwnedBlockAllocatorGroup& operator=(const OwnedBlockAllocatorGroup&) = delete;
+
+		// Each thread claims its own pool and allocates from it
+		[[nodiscard]] auto pool(size_t index) noexcept -> OwnedBlockAllocator&
+		{
+			assert(index < PoolCount && "Pool index out of range");
+			return m_pools[index];
+		}
+
+		[[nodiscard]] auto pool_of(void* ptr) noexcept -> OwnedBlockAllocator&
+		{
+			const size_t index = (ptr_to_address(ptr) - m_baseAddress) / m_poolSize;
+			assert(index < PoolCount && m_pools[index].owns(ptr) && "ptr not allocated by this group");
+			return m_pools[index];
+		}
+
+		void free(void* ptr) noexcept
+		{
+			if (ptr)
+			{
+				pool_of(ptr).free(ptr);
+			}
+		}
+
+	private:
+		[[nodiscard]] static auto pool_size(Block block) noexcept -> size_t
+		{
+			return block.size / PoolCount;
+		}
+
+		template<size_t... Indices>
+		[[nodiscard]] static auto make_pools(Block block, size_t chunkSize, size_t chunkAlignment, std::index_sequence<Indices...>) noexcept -> std::array<OwnedBlockAllocator, PoolCount>
+		{
+			const size_t size = pool_size(block);
+			return { OwnedBlockAllocator(Block{ .address = block.address + Indices * size, .size = size }, chunkSize, chunkAlignment)... };
+		}
+
+		std::array<OwnedBlockAllocator, PoolCount> m_pools;
+		uintptr_t m_baseAddress;
+		size_t m_poolSize;
+	};
+}
+
+#endif //WMCV_OWNED_BLOCK_ALLOCATOR_H_INCLUDED
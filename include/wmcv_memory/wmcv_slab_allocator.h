@@ -0,0 +1,133 @@
+#ifndef WMCV_SLAB_ALLOCATOR_H_INCLUDED
+#define WMCV_SLAB_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+#include "wmcv_block_slab.h"
+
+namespace wmcv::detail
+{
+	inline constexpr size_t SlabMinClassSize = 16;
+	inline constexpr size_t SlabMaxClassSize = 4096;
+
+	// 16 byte steps up to 128, then four classes per power of two
+	inline constexpr size_t SlabClassCount = 8 + 4 * 5;
+
+	[[nodiscard]] constexpr auto make_slab_size_classes() noexcept -> std::array<size_t, SlabClassCount>
+	{
+		std::array<size_t, SlabClassCount> classes = {};
+		size_t index = 0;
+
+		for (size_t size = SlabMinClassSize; size <= 128; size += SlabMinClassSize)
+		{
+			classes[index++] = size;
+		}
+
+		for (size_t base = 128; base < SlabMaxClassSize; base *= 2)
+		{
+			for (size_t step = 1; step <= 4; ++step)
+			{
+				classes[index++] = base + step * (base / 4);
+			}
+		}
+
+		return classes;
+	}
+
+	inline constexpr std::array<size_t, SlabClassCount> SlabSizeClasses = make_slab_size_classes();
+
+	// Maps (size + 15) / 16 to the smallest class that fits
+	[[nodiscard]] constexpr auto make_slab_class_lookup() noexcept -> std::array<uint8_t, SlabMaxClassSize / SlabMinClassSize + 1>
+	{
+		std::array<uint8_t, SlabMaxClassSize / SlabMinClassSize + 1> lookup = {};
+		size_t sizeClass = 0;
+
+		for (size_t i = 0; i < lookup.size(); ++i)
+		{
+			while (SlabSizeClasses[sizeClass] < i * SlabMinClassSize)
+			{
+				++sizeClass;
+			}
+			lookup[i] = static_cast<uint8_t>(sizeClass);
+		}
+
+		return lookup;
+	}
+
+	inline constexpr auto SlabClassLookup = make_slab_class_lookup();
+
+	// Rounding a request up to its class wastes at most a quarter of the class,
+	// or less than one 16 byte step for the small classes
+	[[nodiscard]] constexpr auto slab_classes_bound_fragmentation() noexcept -> bool
+	{
+		for (size_t i = 1; i < SlabClassCount; ++i)
+		{
+			const size_t worst_waste = SlabSizeClasses[i] - SlabSizeClasses[i - 1] - 1;
+			if (SlabSizeClasses[i] <= SlabSizeClasses[i - 1] || (worst_waste >= SlabMinClassSize && worst_waste * 4 > SlabSizeClasses[i]))
+			{
+				return false;
+			}
+		}
+
+		return SlabSizeClasses.back() == SlabMaxClassSize;
+	}
+
+	static_assert(slab_classes_bound_fragmentation(), "Slab size classes leave too large a gap");
+}
+
+namespace wmcv
+{
+	// General purpose allocator for sizes up to 4 KiB. Requests are rounded up
+	// to one of a fixed table of size classes and each class is served from
+	// 64 KiB slabs, each slab a BlockAllocator of that class's chunk size.
+	// Slabs are aligned to their size so free(ptr) finds the slab, and with it
+	// the class, by masking the pointer. Slabs that empty out go back to a
+	// shared pool for any class to reuse.
+	class SlabAllocator
+	{
+	public:
+		static constexpr size_t SlabSize = 64 * 1024;
+		static constexpr size_t MaxSize = detail::SlabMaxClassSize;
+
+		SlabAllocator(Block block) noexcept;
+
+		SlabAllocator(const SlabAllocator&) = delete;
+		SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+		// The returned block's size is the size of the class the request fell into.
+		// NullBlock for sizes above MaxSize
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
+		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block;
+
+		void free(void* ptr) noexcept;
+		void free(void* ptr, size_t size) noexcept;
+		void reset() noexcept;
+
+		[[nodiscard]] static constexpr auto size_class(size_t size) noexcept -> size_t
+		{
+			return detail::SlabClassLookup[(size + detail::SlabMinClassSize - 1) / detail::SlabMinClassSize];
+		}
+
+		[[nodiscard]] static constexpr auto class_size(size_t sizeClass) noexcept -> size_t
+		{
+			return detail::SlabSizeClasses[sizeClass];
+		}
+
+	private:
+		[[nodiscard]] auto allocate_from_class(size_t sizeClass) noexcept -> Block;
+		[[nodiscard]] auto acquire_slab(size_t sizeClass) noexcept -> BlockSlab*;
+		void release_slab(BlockSlab* slab) noexcept;
+		void free_to_slab(BlockSlab* slab, void* ptr) noexcept;
+
+		[[nodiscard]] auto owns_address(uintptr_t address) const noexcept -> bool;
+
+		uintptr_t m_baseAddress;
+		size_t m_slabCount;
+		size_t m_untouchedSlabs;
+		BlockSlab* m_freeSlabs;
+
+		// Slabs of each class that still have free chunks
+		std::array<BlockSlab*, detail::SlabClassCount> m_available;
+	};
+}
+
+#endif //WMCV_SLAB_ALLOCATOR_H_INCLUDED
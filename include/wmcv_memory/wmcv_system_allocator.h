@@ -0,0 +1,18 @@
+#ifndef WMCV_SYSTEM_ALLOCATOR_H_INCLUDED
+#define WMCV_SYSTEM_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+
+namespace wmcv
+{
+	class SystemAllocator
+	{
+	public:
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
+		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block;
+
+		void free(void* ptr) noexcept;
+	};
+}
+
+#endif //WMCV_SYSTEM_ALLOCATOR_H_INCLUDED
@@ -0,0 +1,48 @@
+#ifndef WMCV_THREAD_LOCAL_ARENA_BUFFER_H_INCLUDED
+#define WMCV_THREAD_LOCAL_ARENA_BUFFER_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+
+namespace wmcv
+{
+	class LocklessArenaAllocator;
+
+	// Per-thread allocation buffer carved out of a shared LocklessArenaAllocator.
+	// Each refill takes one buffer from the arena with a single atomic op and
+	// allocations are then bumped out of it without touching shared state.
+	// Requests larger than half a buffer go straight to the arena.
+	//
+	// A buffer must only be used by one thread. Resetting the arena bumps its
+	// epoch, which makes every buffer drop what it holds on its next allocation.
+	class ThreadLocalArenaBuffer
+	{
+	public:
+		static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+		ThreadLocalArenaBuffer(LocklessArenaAllocator& arena, size_t bufferSize = DefaultBufferSize) noexcept;
+
+		ThreadLocalArenaBuffer(const ThreadLocalArenaBuffer&) = delete;
+		ThreadLocalArenaBuffer& operator=(const ThreadLocalArenaBuffer&) = delete;
+
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
+		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block;
+
+		void free(void*) noexcept;
+
+		// Drops the rest of the current buffer, the next allocation refills from the arena
+		void release() noexcept;
+
+		[[nodiscard]] auto remaining() const noexcept -> size_t;
+
+	private:
+		[[nodiscard]] auto refill() noexcept -> bool;
+
+		LocklessArenaAllocator& m_arena;
+		size_t m_bufferSize;
+		size_t m_epoch;
+		uintptr_t m_cursor;
+		uintptr_t m_end;
+	};
+}
+
+#endif //WMCV_THREAD_LOCAL_ARENA_BUFFER_H_INCLUDED
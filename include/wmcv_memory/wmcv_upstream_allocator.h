@@ -0,0 +1,20 @@
+#ifndef WMCV_UPSTREAM_ALLOCATOR_H_INCLUDED
+#define WMCV_UPSTREAM_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+
+namespace wmcv
+{
+	template<typename T>
+	concept UpstreamAllocator = requires(T t, void* ptr) {
+		{ t.allocate(size_t{}) } -> std::same_as<Block>;
+		t.free(ptr);
+	};
+
+	template<typename T>
+	concept AlignedUpstreamAllocator = UpstreamAllocator<T> && requires(T t) {
+		{ t.allocate_aligned(size_t{}, size_t{}) } -> std::same_as<Block>;
+	};
+}
+
+#endif //WMCV_UPSTREAM_ALLOCATOR_H_INCLUDED
@@ -0,0 +1,46 @@
+#ifndef WMCV_VIRTUAL_ARENA_ALLOCATOR_H_INCLUDED
+#define WMCV_VIRTUAL_ARENA_ALLOCATOR_H_INCLUDED
+
+#include "wmcv_memory_block.h"
+
+namespace wmcv
+{
+	// Arena that reserves a range of address space up front and only commits
+	// pages in granules as the marker advances, so resident memory follows
+	// what has actually been allocated rather than the reserved size.
+	class VirtualArenaAllocator
+	{
+	public:
+		static constexpr size_t DefaultCommitGranularity = 64 * 1024;
+
+		VirtualArenaAllocator(size_t reserveSize, size_t commitGranularity = DefaultCommitGranularity) noexcept;
+		~VirtualArenaAllocator() noexcept;
+
+		VirtualArenaAllocator(const VirtualArenaAllocator&) = delete;
+		VirtualArenaAllocator& operator=(const VirtualArenaAllocator&) = delete;
+
+		[[nodiscard]] auto allocate(size_t size) noexcept -> Block;
+		[[nodiscard]] auto allocate_aligned(size_t size, size_t alignment) noexcept -> Block;
+
+		void free(void*) noexcept;
+		void reset() noexcept;
+
+		// Resets the arena and decommits everything above retainSize (rounded up
+		// to the commit granularity) so a one-off spike does not stay resident
+		void reset(size_t retainSize) noexcept;
+
+		[[nodiscard]] auto reserved_size() const noexcept -> size_t;
+		[[nodiscard]] auto committed_size() const noexcept -> size_t;
+
+	private:
+		[[nodiscard]] auto commit(size_t marker) noexcept -> bool;
+
+		uintptr_t m_baseAddress;
+		size_t m_size;
+		size_t m_commitGranularity;
+		size_t m_committed;
+		size_t m_marker;
+	};
+}
+
+#endif //WMCV_VIRTUAL_ARENA_ALLOCATOR_H_INCLUDED
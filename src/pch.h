@@ -5,18 +5,28 @@
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <cstdlib>
 
 #include <type_traits>
+#include <concepts>
+#include <bit>
 #include <algorithm>
+#include <utility>
+#include <new>
 #include <span>
+#include <array>
+#include <memory_resource>
 #include <vector>
 #include <atomic>
 #include <thread>
+#include <mutex>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
 #include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 #endif //WMCV_MEMORY_PCH_H_INCLUDED
\ No newline at end of file
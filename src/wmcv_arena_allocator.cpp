@@ -1,46 +1,188 @@
-#include "pch.h"
-
-#include "wmcv_arena_allocator.h"
-#include "wmcv_allocator_utility.h"
-
-namespace wmcv
-{
-
-ArenaAllocator::ArenaAllocator(Block block) noexcept
-	: m_baseAddress(block.address)
-	, m_size(block.size)
-	, m_marker(0llu)
-{
-}
-
-auto ArenaAllocator::allocate(size_t size) noexcept -> Block
-{
-	constexpr size_t s_default_alignment = 16;
-	return allocate_aligned(size, s_default_alignment);
-}
-
-auto ArenaAllocator::allocate_aligned(size_t size, size_t alignment) noexcept -> Block
-{
-	const uintptr_t curr_ptr = m_baseAddress + m_marker;
-	const uintptr_t offset = align(curr_ptr, alignment) - m_baseAddress;
-
-	if (offset + size <= m_size)
-	{
-		const uintptr_t address = m_baseAddress + offset;
-		m_marker = offset + size;
-		return { .address = address, .size = size };
-	}
-
-	return NullBlock();
-}
-
-void ArenaAllocator::free(void*) noexcept
-{
-}
-
-void ArenaAllocator::reset() noexcept
-{
-	m_marker = 0llu;
-}
-
+#include "pch.h"
+
+#include "wmcv_arena_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+ArenaAllocator::ArenaAllocator(Block block) noexcept
+	: m_baseAddress(block.address)
+	, m_size(block.size)
+	, m_marker(0llu)
+	, m_finalizers(nullptr)
+{
+}
+
+ArenaAllocator::~ArenaAllocator() noexcept
+{
+	run_finalizers(0llu);
+}
+
+auto ArenaAllocator::allocate(size_t size) noexcept -> Block
+{
+	constexpr size_t s_default_alignment = 16;
+	return allocate_aligned(size, s_default_alignment);
+}
+
+auto ArenaAllocator::allocate_aligned(size_t size, size_t alignment) noexcept -> Block
+{
+	const uintptr_t curr_ptr = m_baseAddress + m_marker;
+	const uintptr_t offset = align(curr_ptr, alignment) - m_baseAddress;
+
+	if (offset + size <= m_size)
+	{
+		const uintptr_t address = m_baseAddress + offset;
+		m_marker = offset + size;
+		return { .address = address, .size = size };
+	}
+
+	return NullBlock();
+}
+
+auto ArenaAllocator::allocate_n(size_t count, size_t size, size_t alignment, std::span<Block> blocks) noexcept -> size_t
+{
+	assert(count <= blocks.size() && "Not enough room in blocks for count allocations");
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	const size_t stride = align(size, alignment);
+	if (stride != 0 && count - 1 > m_size / stride)
+	{
+		return 0;
+	}
+
+	const Block range = allocate_aligned(stride * (count - 1) + size, alignment);
+	if (range == NullBlock())
+	{
+		return 0;
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		blocks[i] = { .address = range.address + i * stride, .size = size };
+	}
+
+	return count;
+}
+
+auto ArenaAllocator::try_expand(Block block, size_t new_size) noexcept -> Block
+{
+	assert(new_size >= block.size && "try_expand can't shrink a block, use shrink");
+
+	if (is_last_allocation(block))
+	{
+		const size_t offset = block.address - m_baseAddress;
+		if (offset + new_size <= m_size)
+		{
+			m_marker = offset + new_size;
+			return { .address = block.address, .size = new_size };
+		}
+	}
+
+	return NullBlock();
+}
+
+auto ArenaAllocator::shrink(Block block, size_t new_size) noexcept -> Block
+{
+	assert(new_size <= block.size && "shrink can't grow a block, use try_expand");
+
+	if (is_last_allocation(block))
+	{
+		// objects created in the released range are destroyed as rewind would
+		const Marker marker = block.address - m_baseAddress + new_size;
+		run_finalizers(marker);
+		m_marker = marker;
+		return { .address = block.address, .size = new_size };
+	}
+
+	return NullBlock();
+}
+
+auto ArenaAllocator::reallocate(Block block, size_t new_size) noexcept -> Block
+{
+	constexpr size_t s_default_alignment = 16;
+	return reallocate_aligned(block, new_size, s_default_alignment);
+}
+
+auto ArenaAllocator::reallocate_aligned(Block block, size_t new_size, size_t alignment) noexcept -> Block
+{
+	if (block == NullBlock())
+	{
+		return allocate_aligned(new_size, alignment);
+	}
+
+	// Resizing in place keeps the block's address, which is only any use if it
+	// already meets the alignment being asked for
+	if (is_aligned(block.address, alignment))
+	{
+		if (new_size <= block.size)
+		{
+			// a block that isn't last keeps its space until the arena is reset
+			const Block result = shrink(block, new_size);
+			return result != NullBlock() ? result : Block{ .address = block.address, .size = new_size };
+		}
+
+		if (const Block result = try_expand(block, new_size); result != NullBlock())
+		{
+			return result;
+		}
+	}
+
+	const Block result = allocate_aligned(new_size, alignment);
+	if (result != NullBlock())
+	{
+		std::memcpy(address_to_ptr(result.address), address_to_ptr(block.address), std::min(block.size, new_size));
+	}
+
+	return result;
+}
+
+void ArenaAllocator::free(void*) noexcept
+{
+}
+
+void ArenaAllocator::reset() noexcept
+{
+	run_finalizers(0llu);
+	m_marker = 0llu;
+}
+
+auto ArenaAllocator::get_marker() const noexcept -> Marker
+{
+	return m_marker;
+}
+
+void ArenaAllocator::rewind(Marker marker) noexcept
+{
+	assert(marker <= m_marker && "Rewinding to a marker past the current allocation point");
+	run_finalizers(marker);
+	m_marker = marker;
+}
+
+auto ArenaAllocator::is_last_allocation(Block block) const noexcept -> bool
+{
+	return block.address + block.size == m_baseAddress + m_marker;
+}
+
+void ArenaAllocator::push_finalizer(ArenaFinalizer* finalizer) noexcept
+{
+	finalizer->next = m_finalizers;
+	m_finalizers = finalizer;
+}
+
+void ArenaAllocator::run_finalizers(Marker marker) noexcept
+{
+	// Finalizers are pushed in allocation order so everything above the marker is at the front
+	const uintptr_t end = m_baseAddress + marker;
+	while (m_finalizers && ptr_to_address(m_finalizers) >= end)
+	{
+		ArenaFinalizer* finalizer = std::exchange(m_finalizers, m_finalizers->next);
+		finalizer->destroy(finalizer);
+	}
+}
+
 }
\ No newline at end of file
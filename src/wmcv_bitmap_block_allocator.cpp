@@ -0,0 +1,176 @@
+#include "pch.h"
+
+#include "wmcv_bitmap_block_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+	static constexpr size_t BitsPerWord = 64;
+
+	static constexpr auto ComputeWordCount(size_t bitCount) noexcept -> size_t
+	{
+		return (bitCount + BitsPerWord - 1) / BitsPerWord;
+	}
+
+	static constexpr auto ComputeMetadataSize(size_t chunkCount) noexcept -> size_t
+	{
+		const size_t wordCount = ComputeWordCount(chunkCount);
+		const size_t summaryCount = ComputeWordCount(wordCount);
+		return (wordCount + summaryCount + ComputeWordCount(summaryCount)) * sizeof(uint64_t);
+	}
+
+	// Mask of the bits in use in the last word of a bitmap of bitCount bits
+	static constexpr auto TailMask(size_t bitCount) noexcept -> uint64_t
+	{
+		const size_t tail = bitCount % BitsPerWord;
+		return tail == 0 ? ~uint64_t{0} : (uint64_t{1} << tail) - 1;
+	}
+
+	// Largest chunk count whose metadata and chunks both fit in the block
+	static constexpr auto ComputeChunkCount(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept -> size_t
+	{
+		const uintptr_t metadataAddress = align(block.address, alignof(uint64_t));
+		const uintptr_t end = block.address + block.size;
+		if (metadataAddress >= end)
+		{
+			return 0;
+		}
+
+		// every chunk costs chunkSize bytes plus a little over one bit, start
+		// there and back off until the rounding and alignment padding fit too
+		size_t count = ((end - metadataAddress) * 8) / (chunkSize * 8 + 1);
+		while (count > 0 && align(metadataAddress + ComputeMetadataSize(count), chunkAlignment) + count * chunkSize > end)
+		{
+			--count;
+		}
+
+		return count;
+	}
+
+	BitmapBlockAllocator::BitmapBlockAllocator(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept
+		: m_bitmap(static_cast<uint64_t*>(address_to_ptr(align(block.address, alignof(uint64_t)))))
+		, m_summary(nullptr)
+		, m_top(nullptr)
+		, m_wordCount(0)
+		, m_summaryCount(0)
+		, m_topCount(0)
+		, m_baseAddress(0)
+		, m_chunkSize(align(chunkSize, chunkAlignment))
+		, m_chunkCount(ComputeChunkCount(block, m_chunkSize, chunkAlignment))
+		, m_firstFreeTop(0)
+	{
+		assert(m_chunkCount > 0 && "Memory in block is too small for the bitmap and a chunk");
+
+		m_wordCount = ComputeWordCount(m_chunkCount);
+		m_summaryCount = ComputeWordCount(m_wordCount);
+		m_topCount = ComputeWordCount(m_summaryCount);
+		m_summary = m_bitmap + m_wordCount;
+		m_top = m_summary + m_summaryCount;
+		m_baseAddress = align(ptr_to_address(m_bitmap) + ComputeMetadataSize(m_chunkCount), chunkAlignment);
+		reset();
+	}
+
+	auto BitmapBlockAllocator::allocate() noexcept -> Block
+	{
+		for (size_t top = m_firstFreeTop; top < m_topCount; ++top)
+		{
+			if (m_top[top] != 0)
+			{
+				const size_t summary = top * BitsPerWord + static_cast<size_t>(std::countr_zero(m_top[top]));
+				const size_t word = summary * BitsPerWord + static_cast<size_t>(std::countr_zero(m_summary[summary]));
+				const int bit = std::countr_one(m_bitmap[word]);
+
+				// clear the word's bit in each level above once there's nothing free under it
+				m_bitmap[word] |= uint64_t{1} << bit;
+				if (m_bitmap[word] == ~uint64_t{0})
+				{
+					m_summary[summary] &= ~(uint64_t{1} << (word % BitsPerWord));
+					if (m_summary[summary] == 0)
+					{
+						m_top[top] &= ~(uint64_t{1} << (summary % BitsPerWord));
+					}
+				}
+				m_firstFreeTop = m_top[top] == 0 ? top + 1 : top;
+
+				const size_t index = word * BitsPerWord + static_cast<size_t>(bit);
+				return Block
+				{
+					.address = m_baseAddress + index * m_chunkSize,
+					.size = m_chunkSize
+				};
+			}
+		}
+
+		m_firstFreeTop = m_topCount;
+		return NullBlock();
+	}
+
+	void BitmapBlockAllocator::free(void* ptr) noexcept
+	{
+		if (ptr)
+		{
+			const auto current = ptr_to_address(ptr);
+
+			if (!owns_address(current))
+			{
+				assert(false && "Memory is out of bounds of the buffer in this pool");
+				return;
+			}
+
+			const size_t index = (current - m_baseAddress) / m_chunkSize;
+			const size_t word = index / BitsPerWord;
+			const size_t summary = word / BitsPerWord;
+			const size_t top = summary / BitsPerWord;
+
+			assert((m_bitmap[word] & (uint64_t{1} << (index % BitsPerWord))) != 0 && "Double free of chunk");
+			m_bitmap[word] &= ~(uint64_t{1} << (index % BitsPerWord));
+			m_summary[summary] |= uint64_t{1} << (word % BitsPerWord);
+			m_top[top] |= uint64_t{1} << (summary % BitsPerWord);
+			m_firstFreeTop = std::min(m_firstFreeTop, top);
+		}
+	}
+
+	void BitmapBlockAllocator::reset() noexcept
+	{
+		std::fill_n(m_bitmap, m_wordCount, uint64_t{0});
+		m_bitmap[m_wordCount - 1] = ~TailMask(m_chunkCount);
+
+		std::fill_n(m_summary, m_summaryCount, ~uint64_t{0});
+		m_summary[m_summaryCount - 1] = TailMask(m_wordCount);
+
+		std::fill_n(m_top, m_topCount, ~uint64_t{0});
+		m_top[m_topCount - 1] = TailMask(m_summaryCount);
+
+		m_firstFreeTop = 0;
+	}
+
+	auto BitmapBlockAllocator::chunk_size() const noexcept -> size_t
+	{
+		return m_chunkSize;
+	}
+
+	auto BitmapBlockAllocator::chunk_count() const noexcept -> size_t
+	{
+		return m_chunkCount;
+	}
+
+	auto BitmapBlockAllocator::live_count() const noexcept -> size_t
+	{
+		size_t count = 0;
+		for (size_t word = 0; word < m_wordCount; ++word)
+		{
+			count += static_cast<size_t>(std::popcount(m_bitmap[word] & live_mask(word)));
+		}
+		return count;
+	}
+
+	auto BitmapBlockAllocator::live_mask(size_t word) const noexcept -> uint64_t
+	{
+		return word + 1 < m_wordCount ? ~uint64_t{0} : TailMask(m_chunkCount);
+	}
+
+	auto BitmapBlockAllocator::owns_address(uintptr_t address) const noexcept -> bool
+	{
+		return is_address_in_range(address, m_baseAddress, m_chunkCount * m_chunkSize);
+	}
+}
@@ -18,33 +18,108 @@ namespace wmcv
 		return result;
 	}
 
+	static auto MergeByAddress(BlockFreeListNode* lhs, BlockFreeListNode* rhs) noexcept -> BlockFreeListNode*
+	{
+		BlockFreeListNode head = {.next = nullptr};
+		BlockFreeListNode* tail = &head;
+
+		while (lhs && rhs)
+		{
+			BlockFreeListNode*& lowest = lhs < rhs ? lhs : rhs;
+			tail->next = lowest;
+			tail = lowest;
+			lowest = lowest->next;
+		}
+
+		tail->next = lhs ? lhs : rhs;
+		return head.next;
+	}
+
+	// Bottom up merge sort, bins[i] holds a sorted run of 2^i nodes
+	static auto SortByAddress(BlockFreeListNode* list) noexcept -> BlockFreeListNode*
+	{
+		std::array<BlockFreeListNode*, 64> bins = {};
+
+		while (list)
+		{
+			BlockFreeListNode* carry = std::exchange(list, list->next);
+			carry->next = nullptr;
+
+			size_t bin = 0;
+			for (; bins[bin] != nullptr; ++bin)
+			{
+				carry = MergeByAddress(std::exchange(bins[bin], nullptr), carry);
+			}
+			bins[bin] = carry;
+		}
+
+		BlockFreeListNode* result = nullptr;
+		for (BlockFreeListNode* bin : bins)
+		{
+			result = MergeByAddress(bin, result);
+		}
+		return result;
+	}
+
 	BlockAllocator::BlockAllocator(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept
-		: m_baseAddress(block.address)
+		: m_baseAddress(align(block.address, chunkAlignment))
 		, m_size(ComputeFreeStoreSize(block, chunkAlignment))
 		, m_chunkSize(ComputeChunkSize(chunkSize, chunkAlignment))
+		, m_chunkCount(m_size / m_chunkSize)
+		, m_untouched(0llu)
 		, m_freeStore(nullptr)
+		, m_freesSinceSort(0llu)
 	{
 		assert(m_chunkSize >= sizeof(BlockFreeListNode) && "Chunk size is too small");
 		assert(m_size >= m_chunkSize && "Memory in block is smaller than chunk size");
-
-		reset();
 	}
 
 	[[nodiscard]] auto BlockAllocator::allocate() noexcept -> Block
 	{
 		BlockFreeListNode* node = m_freeStore;
-		if (node == nullptr)
+		if (node != nullptr)
 		{
-			return NullBlock();
+			m_freeStore = node->next;
+
+			return Block
+			{
+				.address = ptr_to_address(node),
+				.size = m_chunkSize
+			};
 		}
 
-		m_freeStore = node->next;
+		if (m_untouched < m_chunkCount)
+		{
+			return Block
+			{
+				.address = m_baseAddress + (m_untouched++ * m_chunkSize),
+				.size = m_chunkSize
+			};
+		}
 
-		return Block
+		return NullBlock();
+	}
+
+	[[nodiscard]] auto BlockAllocator::allocate_n(size_t count, std::span<Block> blocks) noexcept -> size_t
+	{
+		assert(count <= blocks.size() && "Not enough room in blocks for count allocations");
+
+		size_t allocated = 0;
+		BlockFreeListNode* node = m_freeStore;
+		while (allocated < count && node != nullptr)
 		{
-			.address = ptr_to_address(node),
-			.size = m_chunkSize
-		};
+			blocks[allocated++] = { .address = ptr_to_address(node), .size = m_chunkSize };
+			node = node->next;
+		}
+
+		m_freeStore = node;
+
+		while (allocated < count && m_untouched < m_chunkCount)
+		{
+			blocks[allocated++] = { .address = m_baseAddress + (m_untouched++ * m_chunkSize), .size = m_chunkSize };
+		}
+
+		return allocated;
 	}
 
 	void BlockAllocator::free(void* ptr) noexcept
@@ -62,24 +137,36 @@ namespace wmcv
 			auto* node = static_cast<BlockFreeListNode*>(ptr);
 			node->next = m_freeStore;
 			m_freeStore = node;
+			++m_freesSinceSort;
 		}
 	}
 
-	void BlockAllocator::reset() noexcept
+	void BlockAllocator::sort_free_list() noexcept
 	{
-		const size_t chunk_count = m_size / m_chunkSize;
+		m_freeStore = SortByAddress(m_freeStore);
+		m_freesSinceSort = 0llu;
+	}
 
-		for (size_t i = 0; i < chunk_count; i++)
-		{
-			const BlockFreeListNode nodeData = {};
+	auto BlockAllocator::frees_since_sort() const noexcept -> size_t
+	{
+		return m_freesSinceSort;
+	}
 
-			void* ptr = address_to_ptr(m_baseAddress + (i * m_chunkSize));
-			std::memcpy(ptr, &nodeData, sizeof(BlockFreeListNode));
-			auto* node = static_cast<BlockFreeListNode*>(ptr);
+	void BlockAllocator::reset() noexcept
+	{
+		m_freeStore = nullptr;
+		m_untouched = 0llu;
+		m_freesSinceSort = 0llu;
+	}
 
-			node->next = m_freeStore;
-			m_freeStore = node;
-		}
+	auto BlockAllocator::chunk_size() const noexcept -> size_t
+	{
+		return m_chunkSize;
+	}
+
+	auto BlockAllocator::chunk_alignment() const noexcept -> size_t
+	{
+		return wmcv::chunk_alignment(m_baseAddress, m_chunkSize);
 	}
 
 	[[nodiscard]] auto BlockAllocator::owns_address(uintptr_t address) const noexcept -> bool
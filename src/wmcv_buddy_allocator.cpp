@@ -7,30 +7,23 @@ namespace wmcv
 
 static_assert(is_power_of_two(sizeof(BuddyBlock)), "Buddy Block Header must be power of 2");
 
-static BuddyBlock* Next(BuddyBlock* block) noexcept
-{
-	return static_cast<BuddyBlock*>(offset_ptr(block, block->size));
-}
+static constexpr uint32_t s_no_block = ~uint32_t{0};
+static constexpr uint8_t s_free_bit = 0x80;
 
-static void WriteBuddyHeader(void* ptr, size_t size) noexcept
+static constexpr auto ComputeSize(size_t headerSize, size_t alignment, size_t size) noexcept -> size_t
 {
-	const BuddyBlock blockData = {.size = size, .free = true};
-	std::memcpy(ptr, &blockData, sizeof(BuddyBlock));
-}
+	size_t actual_size = alignment;
 
-static constexpr auto ComputeSize(size_t alignment, size_t size) noexcept -> size_t
-{
-    size_t actual_size = alignment;
-    
-    size += sizeof(BuddyBlock);
-	size = align(uintptr_t{size}, alignment); 
-    
-    while (size > actual_size) 
+	// the payload starts headerSize past the start of the block
+	size += headerSize;
+	size = align(uintptr_t{size}, alignment);
+
+	while (size > actual_size)
 	{
-        actual_size *= 2;
-    }
-    
-    return actual_size;
+		actual_size *= 2;
+	}
+
+	return actual_size;
 }
 
 static constexpr auto ComputeAlignment(size_t alignment) noexcept -> size_t
@@ -47,11 +40,37 @@ BuddyAllocator::BuddyAllocator(const Block block, size_t alignment) noexcept
 	: m_baseAddress(block.address)
 	, m_size(block.size)
 	, m_alignment(ComputeAlignment(alignment))
+	, m_alignmentShift(static_cast<size_t>(std::countr_zero(m_alignment)))
+	, m_metadata(nullptr)
+	, m_headerSize(m_alignment)
+	, m_freeMask(0llu)
+	, m_freeLists{}
+{
+	assert(m_baseAddress != 0llu && "Base address is null");
+	assert(is_power_of_two(m_size) && "Size is not a power-of-two");
+	assert(is_power_of_two(m_alignment) && "Alignment is not a power-of-two");
+	assert(m_baseAddress % m_alignment == 0 && "data is not aligned to minimum alignment");
+	assert(m_size / m_alignment < s_no_block && "Too many blocks to index with 32 bits");
+
+	reset();
+}
+
+BuddyAllocator::BuddyAllocator(const Block block, Block metadata, size_t alignment) noexcept
+	: m_baseAddress(block.address)
+	, m_size(block.size)
+	, m_alignment(ComputeAlignment(alignment))
+	, m_alignmentShift(static_cast<size_t>(std::countr_zero(m_alignment)))
+	, m_metadata(static_cast<uint8_t*>(address_to_ptr(metadata.address)))
+	, m_headerSize(0llu)
+	, m_freeMask(0llu)
+	, m_freeLists{}
 {
 	assert(m_baseAddress != 0llu && "Base address is null");
 	assert(is_power_of_two(m_size) && "Size is not a power-of-two");
 	assert(is_power_of_two(m_alignment) && "Alignment is not a power-of-two");
 	assert(m_baseAddress % m_alignment == 0 && "data is not aligned to minimum alignment");
+	assert(m_size / m_alignment < s_no_block && "Too many blocks to index with 32 bits");
+	assert(m_metadata != nullptr && metadata.size >= metadata_size(m_size, m_alignment) && "Metadata block is too small");
 
 	reset();
 }
@@ -63,47 +82,134 @@ BuddyAllocator::BuddyAllocator(const Block block, size_t alignment) noexcept
 		size = m_alignment;
 	}
 
-	const size_t actual_size = ComputeSize(m_alignment, size);
-
-	BuddyBlock* found = search_blocks(actual_size);
-	if (!found)
+	const size_t actual_size = ComputeSize(m_headerSize, m_alignment, size);
+	if (actual_size > m_size)
 	{
-		coalesce();
-		found = search_blocks(actual_size);
+		return NullBlock();
 	}
 
-	if (found && offset_ptr(found, m_alignment) != m_tail)
+	const size_t order = order_of(actual_size);
+	const uint32_t index = take_free_block(order);
+	if (index == s_no_block)
 	{
-		found->free = false;
-		return Block
-		{
-			.address = ptr_to_address(found) + m_alignment,
-			.size = size
-		};
+		return NullBlock();
 	}
 
-	return NullBlock();
+	write_block(index, order, false);
+	return Block
+	{
+		.address = block_address(index) + m_headerSize,
+		.size = size
+	};
 }
 
 void BuddyAllocator::free(void* ptr) noexcept
 {
 	if (ptr)
 	{
-		assert(m_head <= ptr);
-		assert(ptr < m_tail);
+		assert(owns_address(ptr_to_address(ptr)) && "ptr not allocated by this allocator");
+
+		uint32_t index = index_of(ptr_to_address(ptr) - m_headerSize);
+		size_t order = block_order(index);
+		assert(!is_free_block(index, order) && "Double free of block");
+
+		// A block's buddy is at its index with the order's bit flipped, merge up
+		// while the buddy is a free block of the same order
+		while ((m_alignment << order) < m_size)
+		{
+			const uint32_t buddy = index ^ (uint32_t{1} << order);
+			if (!is_free_block(buddy, order))
+			{
+				break;
+			}
+
+			remove_free(buddy, order);
+			index = std::min(index, buddy);
+			++order;
+		}
+
+		write_block(index, order, true);
+		push_free(index, order);
+	}
+}
+
+[[nodiscard]] auto BuddyAllocator::reallocate(Block block, size_t new_size) noexcept -> Block
+{
+	if (block == NullBlock())
+	{
+		return allocate(new_size);
+	}
+
+	assert(owns_address(block.address) && "block not allocated by this allocator");
+
+	const size_t actual_size = ComputeSize(m_headerSize, m_alignment, std::max(new_size, m_alignment));
+	if (actual_size > m_size)
+	{
+		return NullBlock();
+	}
+
+	const uint32_t index = index_of(block.address - m_headerSize);
+	const size_t order = block_order(index);
+	const size_t target = order_of(actual_size);
+
+	if (target <= order)
+	{
+		// the upper half's buddy is the block itself, so nothing can merge with it
+		for (size_t current = order; current > target;)
+		{
+			--current;
+			const uint32_t upper = index + (uint32_t{1} << current);
+			write_block(upper, current, true);
+			push_free(upper, current);
+		}
+
+		write_block(index, target, false);
+		return Block{ .address = block.address, .size = new_size };
+	}
+
+	// Growing in place needs the block to be the lower half at every order up to
+	// target, with each upper half a whole free block
+	bool in_place = true;
+	for (size_t current = order; current < target && in_place; ++current)
+	{
+		const uint32_t buddy = index + (uint32_t{1} << current);
+		in_place = (index & (uint32_t{1} << current)) == 0 && is_free_block(buddy, current);
+	}
+
+	if (in_place)
+	{
+		for (size_t current = order; current < target; ++current)
+		{
+			remove_free(index + (uint32_t{1} << current), current);
+		}
+
+		write_block(index, target, false);
+		return Block{ .address = block.address, .size = new_size };
+	}
 
-		auto* block = static_cast<BuddyBlock*>(offset_ptr_back(ptr, m_alignment));
-		block->free = true;
+	const Block result = allocate(new_size);
+	if (result != NullBlock())
+	{
+		std::memcpy(address_to_ptr(result.address), address_to_ptr(block.address), block.size);
+		free(address_to_ptr(block.address));
 	}
+
+	return result;
 }
 
 void BuddyAllocator::reset() noexcept
 {
-	const BuddyBlock blockData = {.size = m_size, .free = true};
-	void* ptr = address_to_ptr(m_baseAddress);
-	std::memcpy(ptr, &blockData, sizeof(BuddyBlock));
-	m_head = static_cast<BuddyBlock*>(ptr);
-	m_tail = Next(m_head);
+	m_freeMask = 0llu;
+	m_freeLists.fill(s_no_block);
+
+	const size_t order = order_of(m_size);
+	write_block(0, order, true);
+	push_free(0, order);
+}
+
+auto BuddyAllocator::alignment() const noexcept -> size_t
+{
+	return m_alignment;
 }
 
 [[nodiscard]] auto BuddyAllocator::owns_address(uintptr_t address) const noexcept -> bool
@@ -111,130 +217,118 @@ void BuddyAllocator::reset() noexcept
 	return is_address_in_range(address, m_baseAddress, m_size);
 }
 
-[[nodiscard]] auto BuddyAllocator::split_block(BuddyBlock* block, size_t size) noexcept -> BuddyBlock*
+[[nodiscard]] auto BuddyAllocator::order_of(size_t size) const noexcept -> size_t
 {
-	if (block && size > 0)
-	{
-		while (size < block->size)
-		{
-			const size_t sz = block->size / 2;
-			block->size = sz;
-
-			auto* buddy = Next(block);
-			WriteBuddyHeader(buddy, sz);
-		}
+	return static_cast<size_t>(std::countr_zero(size)) - m_alignmentShift;
+}
 
-		if (size <= block->size)
-		{
-			return block;
-		}
-	}
+[[nodiscard]] auto BuddyAllocator::block_address(uint32_t index) const noexcept -> uintptr_t
+{
+	return m_baseAddress + (size_t{index} << m_alignmentShift);
+}
 
-	return nullptr;
+[[nodiscard]] auto BuddyAllocator::index_of(uintptr_t address) const noexcept -> uint32_t
+{
+	return static_cast<uint32_t>((address - m_baseAddress) >> m_alignmentShift);
 }
 
-[[nodiscard]] auto BuddyAllocator::search_blocks(size_t size) noexcept -> BuddyBlock*
+[[nodiscard]] auto BuddyAllocator::links(uint32_t index) const noexcept -> BuddyFreeLinks*
 {
-	BuddyBlock* best = nullptr;
-	BuddyBlock* left = m_head;
-	BuddyBlock* right = Next(left);
+	const size_t offset = m_metadata ? 0 : sizeof(BuddyBlock);
+	return static_cast<BuddyFreeLinks*>(address_to_ptr(block_address(index) + offset));
+}
 
-	if (right == m_tail && left->free)
+[[nodiscard]] auto BuddyAllocator::is_free_block(uint32_t index, size_t order) const noexcept -> bool
+{
+	if (m_metadata)
 	{
-		return split_block(left, size);
+		return m_metadata[index] == (s_free_bit | order);
 	}
 
-	while (left < m_tail && right < m_tail)
+	const auto* header = static_cast<const BuddyBlock*>(address_to_ptr(block_address(index)));
+	return header->free && header->size == (m_alignment << order);
+}
+
+[[nodiscard]] auto BuddyAllocator::block_order(uint32_t index) const noexcept -> size_t
+{
+	if (m_metadata)
 	{
-		if (left->free && right->free && left->size == right->size)
-		{
-			left->size *= 2;
-			if (size <= left->size && (!best || left->size <= best->size))
-			{
-				best = left;
-			}
+		return m_metadata[index] & ~s_free_bit;
+	}
 
-			left = Next(right);
-			if (left < m_tail)
-			{
-				right = Next(left);
-			}
-			continue;
-		}
+	return order_of(static_cast<const BuddyBlock*>(address_to_ptr(block_address(index)))->size);
+}
 
+void BuddyAllocator::write_block(uint32_t index, size_t order, bool free) noexcept
+{
+	if (m_metadata)
+	{
+		m_metadata[index] = static_cast<uint8_t>((free ? s_free_bit : 0) | order);
+		return;
+	}
 
-		if (right->free && size <= right->size && (!best || right->size < best->size))
-		{
-			best = right;
-		}
-		else if (left->free && size <= left->size && (!best || left->size <= best->size))
-		{
-			best = left;
-		}
+	const BuddyBlock blockData = {.size = m_alignment << order, .free = free};
+	std::memcpy(address_to_ptr(block_address(index)), &blockData, sizeof(BuddyBlock));
+}
 
-		if (left->size <= right->size)
-		{
-			left = Next(right);
-			if (left < m_tail)
-			{
-				right = Next(left);
+[[nodiscard]] auto BuddyAllocator::take_free_block(size_t order) noexcept -> uint32_t
+{
+	const size_t available = m_freeMask & (~size_t{0} << order);
+	if (available == 0)
+	{
+		return s_no_block;
+	}
 
-				if (right == m_tail && left->free && size <= left->size && (!best || left->size <= best->size))
-				{
-					best = left;
-				}
-			}
-		}
-		else
-		{
-			left = std::exchange(right, Next(right));
-		}
+	size_t current = static_cast<size_t>(std::countr_zero(available));
+	const uint32_t index = m_freeLists[current];
+	remove_free(index, current);
+
+	// hand the upper half back at each step down
+	while (current > order)
+	{
+		--current;
+		const uint32_t buddy = index + (uint32_t{1} << current);
+		write_block(buddy, current, true);
+		push_free(buddy, current);
 	}
 
-	return split_block(best, size);
+	return index;
 }
 
+void BuddyAllocator::push_free(uint32_t index, size_t order) noexcept
+{
+	const uint32_t head = m_freeLists[order];
+	*links(index) = { .prev = s_no_block, .next = head };
+	if (head != s_no_block)
+	{
+		links(head)->prev = index;
+	}
+
+	m_freeLists[order] = index;
+	m_freeMask |= size_t{1} << order;
+}
 
-void BuddyAllocator::coalesce() noexcept
+void BuddyAllocator::remove_free(uint32_t index, size_t order) noexcept
 {
-	while (true)
+	const BuddyFreeLinks node = *links(index);
+	if (node.prev != s_no_block)
+	{
+		links(node.prev)->next = node.next;
+	}
+	else
 	{
-		BuddyBlock* block = m_head;
-		BuddyBlock* buddy = Next(block);
+		m_freeLists[order] = node.next;
+	}
 
-		bool did_coalesce = false;
-		while (block < m_tail && buddy < m_tail)
-		{
-			if (block->free && buddy->free && block->size == buddy->size)
-			{
-				block->size <<= 1;
-				block = Next(block);
-				if (block < m_tail)
-				{
-					buddy = Next(block);
-					did_coalesce = true;
-				}
-			}
-			else if (block->size < buddy->size)
-			{
-				block = buddy;
-				buddy = Next(buddy);
-			}
-			else
-			{
-				block = Next(buddy);
-				if (block < m_tail)
-				{
-					buddy = Next(block);
-				}
-			}
-		}
+	if (node.next != s_no_block)
+	{
+		links(node.next)->prev = node.prev;
+	}
 
-		if (!did_coalesce)
-		{
-			return;
-		}
+	if (m_freeLists[order] == s_no_block)
+	{
+		m_freeMask &= ~(size_t{1} << order);
 	}
 }
 
-}
\ No newline at end of file
+}
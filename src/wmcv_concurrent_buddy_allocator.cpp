@@ -0,0 +1,230 @@
+#include "pch.h"
+
+#include "wmcv_concurrent_buddy_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+static_assert(sizeof(std::atomic_uint8_t) == 1, "Metadata must be a byte per block");
+
+static constexpr uint32_t s_no_block = ~uint32_t{0};
+static constexpr uint8_t s_free_bit = 0x80;
+
+static constexpr auto ComputeSize(size_t alignment, size_t size) noexcept -> size_t
+{
+	size_t actual_size = alignment;
+	while (size > actual_size)
+	{
+		actual_size *= 2;
+	}
+
+	return actual_size;
+}
+
+static constexpr auto FreeState(size_t order) noexcept -> uint8_t
+{
+	return static_cast<uint8_t>(s_free_bit | order);
+}
+
+ConcurrentBuddyAllocator::ConcurrentBuddyAllocator(const Block block, Block metadata, size_t alignment) noexcept
+	: m_baseAddress(block.address)
+	, m_size(block.size)
+	, m_alignment(std::max(alignment, sizeof(BuddyFreeLinks)))
+	, m_alignmentShift(static_cast<size_t>(std::countr_zero(m_alignment)))
+	, m_maxOrder(order_of(m_size))
+	, m_metadata(static_cast<std::atomic_uint8_t*>(address_to_ptr(metadata.address)))
+	, m_freeMask(0llu)
+	, m_freeLists{}
+{
+	assert(m_baseAddress != 0llu && "Base address is null");
+	assert(is_power_of_two(m_size) && "Size is not a power-of-two");
+	assert(is_power_of_two(m_alignment) && "Alignment is not a power-of-two");
+	assert(m_baseAddress % m_alignment == 0 && "data is not aligned to minimum alignment");
+	assert(m_size / m_alignment < s_no_block && "Too many blocks to index with 32 bits");
+	assert(m_metadata != nullptr && metadata.size >= metadata_size(m_size, m_alignment) && "Metadata block is too small");
+
+	for (size_t i = 0; i < metadata_size(m_size, m_alignment); ++i)
+	{
+		new (m_metadata + i) std::atomic_uint8_t{0};
+	}
+
+	reset();
+}
+
+[[nodiscard]] auto ConcurrentBuddyAllocator::allocate(size_t size) noexcept -> Block
+{
+	const size_t actual_size = ComputeSize(m_alignment, size);
+	if (actual_size > m_size)
+	{
+		return NullBlock();
+	}
+
+	const size_t order = order_of(actual_size);
+	for (;;)
+	{
+		const size_t available = m_freeMask.load(std::memory_order_relaxed) & (~size_t{0} << order);
+		if (available == 0)
+		{
+			return NullBlock();
+		}
+
+		size_t current = static_cast<size_t>(std::countr_zero(available));
+		uint32_t index = s_no_block;
+		{
+			std::scoped_lock lock(m_freeLists[current].lock);
+			index = pop_free(current);
+		}
+
+		// another thread emptied the list since the mask was read
+		if (index == s_no_block)
+		{
+			continue;
+		}
+
+		// hand the upper half back at each step down
+		while (current > order)
+		{
+			--current;
+			std::scoped_lock lock(m_freeLists[current].lock);
+			push_free(index + (uint32_t{1} << current), current);
+		}
+
+		m_metadata[index].store(static_cast<uint8_t>(order), std::memory_order_relaxed);
+		return Block
+		{
+			.address = block_address(index),
+			.size = size
+		};
+	}
+}
+
+void ConcurrentBuddyAllocator::free(void* ptr) noexcept
+{
+	if (ptr)
+	{
+		assert(owns_address(ptr_to_address(ptr)) && "ptr not allocated by this allocator");
+
+		uint32_t index = index_of(ptr_to_address(ptr));
+		size_t order = m_metadata[index].load(std::memory_order_relaxed);
+		assert((order & s_free_bit) == 0 && "Double free of block");
+
+		// The buddy can only become free under this order's lock, so if it isn't
+		// free here the thread freeing it will find this block when it gets the lock
+		for (;;)
+		{
+			std::scoped_lock lock(m_freeLists[order].lock);
+			if (order < m_maxOrder)
+			{
+				const uint32_t buddy = index ^ (uint32_t{1} << order);
+				if (m_metadata[buddy].load(std::memory_order_relaxed) == FreeState(order))
+				{
+					remove_free(buddy, order);
+					index = std::min(index, buddy);
+					++order;
+					continue;
+				}
+			}
+
+			push_free(index, order);
+			return;
+		}
+	}
+}
+
+void ConcurrentBuddyAllocator::reset() noexcept
+{
+	m_freeMask.store(0llu, std::memory_order_relaxed);
+	for (FreeList& list : m_freeLists)
+	{
+		list.head = s_no_block;
+	}
+
+	push_free(0, m_maxOrder);
+}
+
+auto ConcurrentBuddyAllocator::alignment() const noexcept -> size_t
+{
+	return m_alignment;
+}
+
+[[nodiscard]] auto ConcurrentBuddyAllocator::owns_address(uintptr_t address) const noexcept -> bool
+{
+	return is_address_in_range(address, m_baseAddress, m_size);
+}
+
+[[nodiscard]] auto ConcurrentBuddyAllocator::order_of(size_t size) const noexcept -> size_t
+{
+	return static_cast<size_t>(std::countr_zero(size)) - m_alignmentShift;
+}
+
+[[nodiscard]] auto ConcurrentBuddyAllocator::block_address(uint32_t index) const noexcept -> uintptr_t
+{
+	return m_baseAddress + (size_t{index} << m_alignmentShift);
+}
+
+[[nodiscard]] auto ConcurrentBuddyAllocator::index_of(uintptr_t address) const noexcept -> uint32_t
+{
+	return static_cast<uint32_t>((address - m_baseAddress) >> m_alignmentShift);
+}
+
+[[nodiscard]] auto ConcurrentBuddyAllocator::links(uint32_t index) const noexcept -> BuddyFreeLinks*
+{
+	return static_cast<BuddyFreeLinks*>(address_to_ptr(block_address(index)));
+}
+
+[[nodiscard]] auto ConcurrentBuddyAllocator::pop_free(size_t order) noexcept -> uint32_t
+{
+	const uint32_t index = m_freeLists[order].head;
+	if (index != s_no_block)
+	{
+		remove_free(index, order);
+	}
+
+	return index;
+}
+
+void ConcurrentBuddyAllocator::push_free(uint32_t index, size_t order) noexcept
+{
+	const uint32_t head = m_freeLists[order].head;
+	*links(index) = { .prev = s_no_block, .next = head };
+	if (head != s_no_block)
+	{
+		links(head)->prev = index;
+	}
+	else
+	{
+		m_freeMask.fetch_or(size_t{1} << order, std::memory_order_relaxed);
+	}
+
+	m_freeLists[order].head = index;
+	m_metadata[index].store(FreeState(order), std::memory_order_relaxed);
+}
+
+void ConcurrentBuddyAllocator::remove_free(uint32_t index, size_t order) noexcept
+{
+	const BuddyFreeLinks node = *links(index);
+	if (node.prev != s_no_block)
+	{
+		links(node.prev)->next = node.next;
+	}
+	else
+	{
+		m_freeLists[order].head = node.next;
+	}
+
+	if (node.next != s_no_block)
+	{
+		links(node.next)->prev = node.prev;
+	}
+
+	if (m_freeLists[order].head == s_no_block)
+	{
+		m_freeMask.fetch_and(~(size_t{1} << order), std::memory_order_relaxed);
+	}
+
+	// in flight, the caller either hands it out or carries it to another order
+	m_metadata[index].store(static_cast<uint8_t>(order), std::memory_order_relaxed);
+}
+
+}
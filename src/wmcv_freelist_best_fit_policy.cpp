@@ -120,6 +120,11 @@ auto FreeListBestFitPolicy::allocate_aligned(size_t size, size_t alignment) noex
 
 		insert_node(new_node);
 	}
+	else
+	{
+		// the tail is too small to hold a node, hand it out with the allocation so free returns it
+		required_space = node->size;
+	}
 
 	remove_node(node);
 	m_used += required_space;
@@ -178,16 +183,25 @@ auto FreeListBestFitPolicy::coalesce(detail::Node* node) noexcept -> void
 {
 	assert(node && "node is a nullptr");
 
+	// the tree is keyed on size so nodes have to come out of it before they grow
 	if (node->next && offset_ptr(node, node->size) == node->next)
 	{
-		node->size += node->next->size;
-		remove_node(node->next);
+		detail::Node* next = node->next;
+		remove_node(next);
+
+		Remove(m_root, node);
+		node->size += next->size;
+		Insert(m_root, node);
 	}
 
 	if (node->prev && offset_ptr(node->prev, node->prev->size) == node)
 	{
-		node->prev->size += node->size;
+		detail::Node* prev = node->prev;
 		remove_node(node);
+
+		Remove(m_root, prev);
+		prev->size += node->size;
+		Insert(m_root, prev);
 	}
 }
 
@@ -6,11 +6,25 @@
 namespace wmcv
 {
 
-LocklessArenaAllocator::LocklessArenaAllocator(Block block) noexcept
-: m_baseAddress(block.address)
-, m_size(block.size)
+static auto AlignedBaseOffset(Block block, size_t granule) noexcept -> size_t
+{
+    return align(block.address, granule) - block.address;
+}
+
+LocklessArenaAllocator::LocklessArenaAllocator(Block block, size_t granule) noexcept
+: m_baseAddress(block.address + AlignedBaseOffset(block, granule))
+, m_size(block.size > AlignedBaseOffset(block, granule) ? block.size - AlignedBaseOffset(block, granule) : 0llu)
+, m_granule(granule)
+, m_epoch(0llu)
 , m_marker(0llu)
+, m_finalizers(nullptr)
 {
+    assert(is_power_of_two(m_granule) && "Granule is not a power-of-two");
+}
+
+LocklessArenaAllocator::~LocklessArenaAllocator() noexcept
+{
+    run_finalizers(0llu);
 }
 
 auto LocklessArenaAllocator::allocate(size_t size) noexcept -> Block
@@ -21,31 +35,148 @@ auto LocklessArenaAllocator::allocate(size_t size) noexcept -> Block
 
 auto LocklessArenaAllocator::allocate_aligned(size_t size, size_t alignment) noexcept -> Block
 {
-    size_t old_marker = m_marker.load();
+    if (alignment > m_granule)
+        return allocate_contended(size, alignment);
+    
+    if (size > m_size)
+        return NullBlock();
+    
+    // The marker is always a multiple of the granule so the base + offset is
+    // already aligned, which lets every thread claim its range in one fetch_add
+    const size_t rounded = align(size, m_granule);
+    const size_t offset = m_marker.fetch_add(rounded, std::memory_order_relaxed);
+    
+    if (offset + rounded > m_size)
+    {
+        // Overflowed, give the range back only if nobody has claimed past it since.
+        // Otherwise the marker stays past the end until reset or rewind, a blind
+        // fetch_sub could move it back under a range that's been handed out
+        size_t expected = offset + rounded;
+        m_marker.compare_exchange_strong(expected, offset, std::memory_order_relaxed);
+        return NullBlock();
+    }
+    
+    return { .address = m_baseAddress + offset, .size = size };
+}
+
+auto LocklessArenaAllocator::allocate_n(size_t count, size_t size, size_t alignment, std::span<Block> blocks) noexcept -> size_t
+{
+    assert(count <= blocks.size() && "Not enough room in blocks for count allocations");
+    
+    if (count == 0)
+        return 0;
+    
+    const size_t stride = align(size, alignment);
+    if (stride != 0 && count - 1 > m_size / stride)
+        return 0;
+    
+    const Block range = allocate_aligned(stride * (count - 1) + size, alignment);
+    if (range == NullBlock())
+        return 0;
+    
+    for (size_t i = 0; i < count; ++i)
+    {
+        blocks[i] = { .address = range.address + i * stride, .size = size };
+    }
+    
+    return count;
+}
+
+void LocklessArenaAllocator::free(void*) noexcept
+{
+}
+
+void LocklessArenaAllocator::reset() noexcept
+{
+    run_finalizers(0llu);
+    m_epoch.fetch_add(1);
+    m_marker.store(0llu);
+}
+
+auto LocklessArenaAllocator::get_marker() const noexcept -> Marker
+{
+    return std::min(m_marker.load(), m_size);
+}
+
+void LocklessArenaAllocator::rewind(Marker marker) noexcept
+{
+    size_t current = m_marker.load();
+    assert(marker <= current && "Rewinding to a marker past the current allocation point");
+
+    run_finalizers(marker);
+
+    [[maybe_unused]] const bool quiescent = m_marker.compare_exchange_strong(current, marker);
+    assert(quiescent && "Arena was allocated from by another thread during rewind");
+}
+
+auto LocklessArenaAllocator::allocate_contended(size_t size, size_t alignment) noexcept -> Block
+{
+    if (size > m_size)
+        return NullBlock();
+    
+    const size_t rounded = align(size, m_granule);
+    size_t old_marker = m_marker.load(std::memory_order_relaxed);
     size_t new_marker = 0;
     
     do
     {
         const uintptr_t curr_ptr = m_baseAddress + old_marker;
-        new_marker = align(curr_ptr, alignment) + size - m_baseAddress;
+        new_marker = align(curr_ptr, alignment) + rounded - m_baseAddress;
         
         if (new_marker > m_size)
             return NullBlock();
         
-    } while( !m_marker.compare_exchange_weak(old_marker, new_marker) );
+    } while( !m_marker.compare_exchange_weak(old_marker, new_marker, std::memory_order_relaxed) );
     
-    const uintptr_t offset = new_marker - size;
+    const uintptr_t offset = new_marker - rounded;
     const uintptr_t address = m_baseAddress + offset;
     return { .address = address, .size = size };
 }
 
-void LocklessArenaAllocator::free(void*) noexcept
+void LocklessArenaAllocator::push_finalizer(ArenaFinalizer* finalizer) noexcept
 {
+    finalizer->next = m_finalizers.load(std::memory_order_relaxed);
+    while (!m_finalizers.compare_exchange_weak(finalizer->next, finalizer, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
 }
 
-void LocklessArenaAllocator::reset() noexcept
+void LocklessArenaAllocator::run_finalizers(Marker marker) noexcept
 {
-    m_marker.store(0llu);
+    // Threads can push out of allocation order so the whole list is walked,
+    // this only runs while the arena is quiescent
+    const uintptr_t end = m_baseAddress + marker;
+    ArenaFinalizer* finalizer = m_finalizers.load(std::memory_order_acquire);
+    ArenaFinalizer* kept = nullptr;
+    ArenaFinalizer** tail = &kept;
+    
+    while (finalizer)
+    {
+        ArenaFinalizer* next = finalizer->next;
+        if (ptr_to_address(finalizer) >= end)
+        {
+            finalizer->destroy(finalizer);
+        }
+        else
+        {
+            *tail = finalizer;
+            tail = &finalizer->next;
+        }
+        finalizer = next;
+    }
+    
+    *tail = nullptr;
+    m_finalizers.store(kept, std::memory_order_release);
+}
+
+auto LocklessArenaAllocator::epoch() const noexcept -> size_t
+{
+    return m_epoch.load(std::memory_order_acquire);
+}
+
+auto LocklessArenaAllocator::granule() const noexcept -> size_t
+{
+    return m_granule;
 }
 
 }
@@ -5,6 +5,8 @@
 
 namespace wmcv
 {
+	static constexpr uint32_t s_empty_index = ~uint32_t{0};
+
 	constexpr static auto ComputeFreeStoreSize(const Block block, const size_t alignment) noexcept -> size_t
 	{
 		const auto start = align(block.address, alignment);
@@ -18,75 +20,235 @@ namespace wmcv
 		return result;
 	}
 
+	constexpr static auto ComputeChunkCount(size_t size, size_t chunkSize) noexcept -> size_t
+	{
+		// the empty marker is the one index that can't name a chunk
+		return std::min(size / chunkSize, size_t{s_empty_index});
+	}
+
+	constexpr static auto PackHead(uint32_t index, uint32_t version) noexcept -> uint64_t
+	{
+		return (uint64_t{version} << 32) | index;
+	}
+
+	constexpr static auto HeadIndex(uint64_t head) noexcept -> uint32_t
+	{
+		return static_cast<uint32_t>(head);
+	}
+
+	constexpr static auto HeadVersion(uint64_t head) noexcept -> uint32_t
+	{
+		return static_cast<uint32_t>(head >> 32);
+	}
+
+	static auto NextRef(uintptr_t address) noexcept -> std::atomic_ref<uint32_t>
+	{
+		return std::atomic_ref<uint32_t>(*static_cast<uint32_t*>(address_to_ptr(address)));
+	}
+
 	LocklessBlockAllocator::LocklessBlockAllocator(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept
-		: m_baseAddress(block.address)
+		: m_baseAddress(align(block.address, chunkAlignment))
 		, m_size(ComputeFreeStoreSize(block, chunkAlignment))
 		, m_chunkSize(ComputeChunkSize(chunkSize, chunkAlignment))
-		, m_freeStore(nullptr)
+		, m_chunkCount(ComputeChunkCount(m_size, m_chunkSize))
+		, m_untouched(0llu)
+		, m_freeStore(PackHead(s_empty_index, 0))
 	{
-		assert(m_chunkSize >= sizeof(BlockFreeListNode) && "Chunk size is too small");
+		assert(m_chunkSize >= sizeof(uint32_t) && "Chunk size is too small");
+		assert(chunk_alignment() >= std::atomic_ref<uint32_t>::required_alignment && "Chunks are not aligned for the free list index");
 		assert(m_size >= m_chunkSize && "Memory in block is smaller than chunk size");
-
-		reset();
 	}
 
 	[[nodiscard]] auto LocklessBlockAllocator::allocate() noexcept -> Block
 	{
-		BlockFreeListNode* node = m_freeStore.load();
+		uint64_t head = m_freeStore.load(std::memory_order_acquire);
 
-		do
+		while (HeadIndex(head) != s_empty_index)
 		{
-			if (node == nullptr)
+			// next may be stale if another thread pops this chunk first, the
+			// version check in the CAS then rejects it
+			const uint64_t next = PackHead(next_index(HeadIndex(head)), HeadVersion(head) + 1);
+			if (m_freeStore.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
 			{
-				return NullBlock();
+				return Block
+				{
+					.address = chunk_address(HeadIndex(head)),
+					.size = m_chunkSize
+				};
 			}
 		}
-		while (!m_freeStore.compare_exchange_weak(node, node->next));
 
-		return Block
-		{
-			.address = ptr_to_address(node),
-			.size = m_chunkSize
-		};
+		Block result = NullBlock();
+		(void)allocate_untouched(1, std::span(&result, 1));
+		return result;
 	}
 
-	void LocklessBlockAllocator::free(void* ptr) noexcept
+	[[nodiscard]] auto LocklessBlockAllocator::allocate_n(size_t count, std::span<Block> blocks) noexcept -> size_t
 	{
-		if (ptr)
+		assert(count <= blocks.size() && "Not enough room in blocks for count allocations");
+
+		if (count == 0)
 		{
-			const auto current = ptr_to_address(ptr);
+			return 0;
+		}
 
-			if (!owns_address(current))
+		// Find the end of the run to take, then detach the whole run with one CAS
+		uint64_t head = m_freeStore.load(std::memory_order_acquire);
+		size_t allocated = 0;
+
+		while (HeadIndex(head) != s_empty_index)
+		{
+			uint32_t last = HeadIndex(head);
+			uint32_t after = next_index(last);
+			allocated = 1;
+			while (allocated < count && after < m_chunkCount)
+			{
+				last = after;
+				after = next_index(last);
+				++allocated;
+			}
+
+			// Another thread popped part of the run and wrote over its link, so it
+			// can't be followed any further. The CAS would fail anyway, start again
+			if (after != s_empty_index && after >= m_chunkCount)
 			{
-				assert(false && "Memory is out of bounds of the buffer in this pool");
-				return;
+				head = m_freeStore.load(std::memory_order_acquire);
+				allocated = 0;
+				continue;
 			}
 
-			auto* node = static_cast<BlockFreeListNode*>(ptr);
-			node->next = m_freeStore;
-			m_freeStore = node;
+			const uint64_t next = PackHead(after, HeadVersion(head) + 1);
+			if (m_freeStore.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+			{
+				break;
+			}
+
+			allocated = 0;
+		}
+
+		uint32_t index = HeadIndex(head);
+		for (size_t i = 0; i < allocated; ++i)
+		{
+			blocks[i] = { .address = chunk_address(index), .size = m_chunkSize };
+			index = next_index(index);
+		}
+
+		if (allocated < count)
+		{
+			allocated += allocate_untouched(count - allocated, blocks.subspan(allocated));
 		}
+
+		return allocated;
 	}
 
-	void LocklessBlockAllocator::reset() noexcept
+	void LocklessBlockAllocator::free(void* ptr) noexcept
+	{
+		free_chain(ptr, ptr);
+	}
+
+	void LocklessBlockAllocator::free_batch(std::span<void* const> ptrs) noexcept
+	{
+		if (ptrs.empty())
+		{
+			return;
+		}
+
+		for (size_t i = 1; i < ptrs.size(); ++i)
+		{
+			chain(ptrs[i - 1], ptrs[i]);
+		}
+
+		free_chain(ptrs.front(), ptrs.back());
+	}
+
+	void LocklessBlockAllocator::chain(void* ptr, void* next) noexcept
 	{
-		const size_t chunk_count = m_size / m_chunkSize;
+		assert(ptr && next && "Can't chain a null chunk");
+		NextRef(ptr_to_address(ptr)).store(chunk_index(ptr_to_address(next)), std::memory_order_relaxed);
+	}
 
-		for (size_t i = 0; i < chunk_count; i++)
+	void LocklessBlockAllocator::free_chain(void* first, void* last) noexcept
+	{
+		if (first == nullptr)
 		{
-			const BlockFreeListNode nodeData = {};
+			return;
+		}
 
-			void* ptr = address_to_ptr(m_baseAddress + (i * m_chunkSize));
-			std::memcpy(ptr, &nodeData, sizeof(BlockFreeListNode));
-			auto* node = static_cast<BlockFreeListNode*>(ptr);
+		assert(last != nullptr && "Chain has a first chunk but no last chunk");
 
-			node->next = m_freeStore;
-			m_freeStore = node;
+		const auto firstAddress = ptr_to_address(first);
+		const auto lastAddress = ptr_to_address(last);
+		if (!owns_address(firstAddress) || !owns_address(lastAddress))
+		{
+			assert(false && "Memory is out of bounds of the buffer in this pool");
+			return;
 		}
+
+		const uint32_t index = chunk_index(firstAddress);
+
+		uint64_t head = m_freeStore.load(std::memory_order_relaxed);
+		uint64_t next = 0;
+		do
+		{
+			NextRef(lastAddress).store(HeadIndex(head), std::memory_order_relaxed);
+			next = PackHead(index, HeadVersion(head) + 1);
+		}
+		while (!m_freeStore.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	void LocklessBlockAllocator::reset() noexcept
+	{
+		m_freeStore.store(PackHead(s_empty_index, HeadVersion(m_freeStore.load()) + 1));
+		m_untouched.store(0llu);
+	}
+
+	auto LocklessBlockAllocator::chunk_size() const noexcept -> size_t
+	{
+		return m_chunkSize;
+	}
+
+	auto LocklessBlockAllocator::chunk_alignment() const noexcept -> size_t
+	{
+		return wmcv::chunk_alignment(m_baseAddress, m_chunkSize);
 	}
 
 	[[nodiscard]] auto LocklessBlockAllocator::owns_address(uintptr_t address) const noexcept -> bool
 	{
-		return is_address_in_range(address, m_baseAddress, m_size);
+		return is_address_in_range(address, m_baseAddress, m_chunkCount * m_chunkSize);
+	}
+
+	[[nodiscard]] auto LocklessBlockAllocator::chunk_index(uintptr_t address) const noexcept -> uint32_t
+	{
+		assert(owns_address(address) && "Memory is out of bounds of the buffer in this pool");
+		assert((address - m_baseAddress) % m_chunkSize == 0 && "Pointer is not the start of a chunk");
+		return static_cast<uint32_t>((address - m_baseAddress) / m_chunkSize);
+	}
+
+	[[nodiscard]] auto LocklessBlockAllocator::chunk_address(uint32_t index) const noexcept -> uintptr_t
+	{
+		return m_baseAddress + (size_t{index} * m_chunkSize);
+	}
+
+	[[nodiscard]] auto LocklessBlockAllocator::next_index(uint32_t index) const noexcept -> uint32_t
+	{
+		return NextRef(chunk_address(index)).load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] auto LocklessBlockAllocator::allocate_untouched(size_t count, std::span<Block> blocks) noexcept -> size_t
+	{
+		if (m_untouched.load(std::memory_order_relaxed) >= m_chunkCount)
+		{
+			return 0;
+		}
+
+		const size_t first = m_untouched.fetch_add(count, std::memory_order_relaxed);
+		const size_t available = first < m_chunkCount ? std::min(count, m_chunkCount - first) : 0;
+
+		for (size_t i = 0; i < available; ++i)
+		{
+			blocks[i] = { .address = m_baseAddress + ((first + i) * m_chunkSize), .size = m_chunkSize };
+		}
+
+		return available;
 	}
-}
\ No newline at end of file
+}
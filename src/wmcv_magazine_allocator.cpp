@@ -0,0 +1,205 @@
+#include "pch.h"
+
+#include "wmcv_magazine_allocator.h"
+#include "wmcv_lockless_block_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+static void PushChunk(Magazine& magazine, void* ptr) noexcept
+{
+	auto* chunk = static_cast<MagazineChunk*>(ptr);
+	chunk->next = magazine.head;
+	magazine.head = chunk;
+	++magazine.count;
+}
+
+static auto PopChunk(Magazine& magazine) noexcept -> void*
+{
+	MagazineChunk* chunk = magazine.head;
+	magazine.head = chunk->next;
+	--magazine.count;
+	return chunk;
+}
+
+MagazineDepot::MagazineDepot(LocklessBlockAllocator& pool, size_t magazineSize) noexcept
+	: m_pool(pool)
+	, m_magazineSize(magazineSize)
+	, m_full(nullptr)
+	, m_fullCount(0llu)
+{
+	assert(m_magazineSize > 0 && "Magazine size must be non-zero");
+	assert(m_pool.chunk_size() >= sizeof(MagazineChunk) && "Pool chunks are too small to link into magazines");
+	assert(m_pool.chunk_alignment() >= alignof(MagazineChunk) && "Pool chunks are not aligned for magazine links");
+}
+
+MagazineDepot::~MagazineDepot() noexcept
+{
+	while (m_full)
+	{
+		MagazineChunk* head = std::exchange(m_full, m_full->nextMagazine);
+		free_to_pool({ .head = head, .count = m_magazineSize });
+	}
+}
+
+auto MagazineDepot::acquire() noexcept -> Magazine
+{
+	{
+		std::scoped_lock lock(m_lock);
+		if (m_full)
+		{
+			MagazineChunk* head = std::exchange(m_full, m_full->nextMagazine);
+			--m_fullCount;
+			return { .head = head, .count = m_magazineSize };
+		}
+	}
+
+	// Nothing in the depot, take a magazine's worth from the pool in one go
+	constexpr size_t s_batch_size = 64;
+	std::array<Block, s_batch_size> blocks;
+
+	Magazine magazine = { .head = nullptr, .count = 0 };
+	while (magazine.count < m_magazineSize)
+	{
+		const size_t wanted = std::min(s_batch_size, m_magazineSize - magazine.count);
+		const size_t count = m_pool.allocate_n(wanted, blocks);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			PushChunk(magazine, address_to_ptr(blocks[i].address));
+		}
+
+		if (count < wanted)
+		{
+			break;
+		}
+	}
+
+	return magazine;
+}
+
+void MagazineDepot::release(Magazine magazine) noexcept
+{
+	if (magazine.count < m_magazineSize)
+	{
+		free_to_pool(magazine);
+		return;
+	}
+
+	std::scoped_lock lock(m_lock);
+	magazine.head->nextMagazine = std::exchange(m_full, magazine.head);
+	++m_fullCount;
+}
+
+auto MagazineDepot::pool() const noexcept -> LocklessBlockAllocator&
+{
+	return m_pool;
+}
+
+auto MagazineDepot::magazine_size() const noexcept -> size_t
+{
+	return m_magazineSize;
+}
+
+auto MagazineDepot::full_magazines() const noexcept -> size_t
+{
+	std::scoped_lock lock(m_lock);
+	return m_fullCount;
+}
+
+void MagazineDepot::free_to_pool(Magazine magazine) noexcept
+{
+	if (magazine.count == 0)
+	{
+		return;
+	}
+
+	// Relink the magazine in the pool's format and push it back in one go, each
+	// link is read before chain overwrites it
+	MagazineChunk* first = magazine.head;
+	MagazineChunk* last = first;
+	for (size_t i = 1; i < magazine.count; ++i)
+	{
+		MagazineChunk* next = last->next;
+		m_pool.chain(last, next);
+		last = next;
+	}
+
+	m_pool.free_chain(first, last);
+}
+
+MagazineCache::MagazineCache(MagazineDepot& depot) noexcept
+	: m_depot(depot)
+	, m_chunkSize(depot.pool().chunk_size())
+	, m_loaded{ .head = nullptr, .count = 0 }
+	, m_previous{ .head = nullptr, .count = 0 }
+{
+}
+
+MagazineCache::~MagazineCache() noexcept
+{
+	flush();
+}
+
+auto MagazineCache::allocate() noexcept -> Block
+{
+	if (m_loaded.count == 0)
+	{
+		if (m_previous.count > 0)
+		{
+			std::swap(m_loaded, m_previous);
+		}
+		else
+		{
+			m_loaded = m_depot.acquire();
+			if (m_loaded.count == 0)
+			{
+				return NullBlock();
+			}
+		}
+	}
+
+	return { .address = ptr_to_address(PopChunk(m_loaded)), .size = m_chunkSize };
+}
+
+void MagazineCache::free(void* ptr) noexcept
+{
+	if (!ptr)
+	{
+		return;
+	}
+
+	const size_t capacity = m_depot.magazine_size();
+	if (m_loaded.count == capacity)
+	{
+		if (m_previous.count == capacity)
+		{
+			m_depot.release(m_previous);
+			m_previous = { .head = nullptr, .count = 0 };
+		}
+
+		std::swap(m_loaded, m_previous);
+	}
+
+	PushChunk(m_loaded, ptr);
+}
+
+void MagazineCache::flush() noexcept
+{
+	for (Magazine* magazine : { &m_loaded, &m_previous })
+	{
+		if (magazine->count > 0)
+		{
+			m_depot.release(*magazine);
+			*magazine = { .head = nullptr, .count = 0 };
+		}
+	}
+}
+
+auto MagazineCache::cached() const noexcept -> size_t
+{
+	return m_loaded.count + m_previous.count;
+}
+
+}
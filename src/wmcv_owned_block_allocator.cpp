@@ -0,0 +1,84 @@
+#include "pch.h"
+
+#include "wmcv_owned_block_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+	OwnedBlockAllocator::OwnedBlockAllocator(const Block block, size_t chunkSize, size_t chunkAlignment) noexcept
+		: m_local(block, chunkSize, chunkAlignment)
+		, m_baseAddress(block.address)
+		, m_size(block.size)
+		, m_owner(std::this_thread::get_id())
+		, m_remoteFree(nullptr)
+	{
+	}
+
+	auto OwnedBlockAllocator::allocate() noexcept -> Block
+	{
+		assert(std::this_thread::get_id() == m_owner.load(std::memory_order_relaxed) && "Only the owning thread may allocate");
+
+		const Block result = m_local.allocate();
+		if (result != NullBlock() || drain_remote_frees() == 0)
+		{
+			return result;
+		}
+
+		return m_local.allocate();
+	}
+
+	void OwnedBlockAllocator::free(void* ptr) noexcept
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		// A thread that isn't the owner can't read its own id here mid claim,
+		// so it can only ever take the remote path
+		if (std::this_thread::get_id() == m_owner.load(std::memory_order_acquire))
+		{
+			m_local.free(ptr);
+			return;
+		}
+
+		assert(owns(ptr) && "Memory is out of bounds of the buffer in this pool");
+
+		// Only the owner pops and it takes the whole stack at once, so a plain
+		// pointer CAS can't suffer from ABA here
+		auto* node = static_cast<BlockFreeListNode*>(ptr);
+		node->next = m_remoteFree.load(std::memory_order_relaxed);
+		while (!m_remoteFree.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	auto OwnedBlockAllocator::drain_remote_frees() noexcept -> size_t
+	{
+		BlockFreeListNode* node = m_remoteFree.exchange(nullptr, std::memory_order_acquire);
+
+		size_t count = 0;
+		while (node)
+		{
+			m_local.free(std::exchange(node, node->next));
+			++count;
+		}
+
+		return count;
+	}
+
+	void OwnedBlockAllocator::claim() noexcept
+	{
+		m_owner.store(std::this_thread::get_id(), std::memory_order_release);
+	}
+
+	auto OwnedBlockAllocator::owns(void* ptr) const noexcept -> bool
+	{
+		return is_address_in_range(ptr_to_address(ptr), m_baseAddress, m_size);
+	}
+
+	auto OwnedBlockAllocator::chunk_size() const noexcept -> size_t
+	{
+		return m_local.chunk_size();
+	}
+}
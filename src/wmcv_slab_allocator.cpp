@@ -0,0 +1,172 @@
+#include "pch.h"
+
+#include "wmcv_slab_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+static constexpr auto ComputeSlabCount(const Block block) noexcept -> size_t
+{
+	const uintptr_t start = align(block.address, SlabAllocator::SlabSize);
+	const size_t skipped = start - block.address;
+	return block.size > skipped ? (block.size - skipped) / SlabAllocator::SlabSize : 0;
+}
+
+static constexpr auto ClassAlignment(size_t sizeClass) noexcept -> size_t
+{
+	// chunks sit at multiples of the class size past an offset aligned to the
+	// same bit, so the lowest set bit of the size is what they're aligned to
+	const size_t size = SlabAllocator::class_size(sizeClass);
+	return size & (~size + 1);
+}
+
+SlabAllocator::SlabAllocator(Block block) noexcept
+	: m_baseAddress(align(block.address, SlabSize))
+	, m_slabCount(ComputeSlabCount(block))
+	, m_untouchedSlabs(0llu)
+	, m_freeSlabs(nullptr)
+	, m_available{}
+{
+	assert(m_slabCount > 0 && "Block is too small to hold an aligned slab");
+}
+
+auto SlabAllocator::allocate(size_t size) noexcept -> Block
+{
+	if (size > MaxSize)
+	{
+		return NullBlock();
+	}
+
+	return allocate_from_class(size_class(size));
+}
+
+auto SlabAllocator::allocate_aligned(size_t size, size_t alignment) noexcept -> Block
+{
+	if (alignment <= detail::SlabMinClassSize)
+	{
+		return allocate(size);
+	}
+
+	if (size > MaxSize || alignment > MaxSize)
+	{
+		return NullBlock();
+	}
+
+	for (size_t sizeClass = size_class(size); sizeClass < detail::SlabClassCount; ++sizeClass)
+	{
+		if (ClassAlignment(sizeClass) >= alignment)
+		{
+			return allocate_from_class(sizeClass);
+		}
+	}
+
+	return NullBlock();
+}
+
+void SlabAllocator::free(void* ptr) noexcept
+{
+	if (ptr)
+	{
+		assert(owns_address(ptr_to_address(ptr)) && "ptr not allocated by this allocator");
+		free_to_slab(detail::slab_of(ptr_to_address(ptr), SlabSize), ptr);
+	}
+}
+
+void SlabAllocator::free(void* ptr, size_t size) noexcept
+{
+	if (ptr)
+	{
+		assert(owns_address(ptr_to_address(ptr)) && "ptr not allocated by this allocator");
+
+		BlockSlab* slab = detail::slab_of(ptr_to_address(ptr), SlabSize);
+		assert(class_size(slab->sizeClass) >= size && "size is larger than the class ptr was allocated from");
+		(void)size;
+
+		free_to_slab(slab, ptr);
+	}
+}
+
+void SlabAllocator::reset() noexcept
+{
+	m_untouchedSlabs = 0llu;
+	m_freeSlabs = nullptr;
+	m_available.fill(nullptr);
+}
+
+auto SlabAllocator::allocate_from_class(size_t sizeClass) noexcept -> Block
+{
+	BlockSlab* slab = m_available[sizeClass];
+	if (slab == nullptr)
+	{
+		slab = acquire_slab(sizeClass);
+		if (slab == nullptr)
+		{
+			return NullBlock();
+		}
+
+		detail::link_slab(m_available[sizeClass], slab);
+	}
+
+	const Block result = slab->chunks.allocate();
+	assert(result != NullBlock() && "Slab on the available list has no free chunks");
+
+	if (++slab->live == slab->capacity)
+	{
+		detail::unlink_slab(m_available[sizeClass], slab);
+	}
+
+	return result;
+}
+
+auto SlabAllocator::acquire_slab(size_t sizeClass) noexcept -> BlockSlab*
+{
+	uintptr_t address = 0;
+	if (m_freeSlabs)
+	{
+		address = ptr_to_address(std::exchange(m_freeSlabs, m_freeSlabs->next));
+	}
+	else if (m_untouchedSlabs < m_slabCount)
+	{
+		address = m_baseAddress + (m_untouchedSlabs++ * SlabSize);
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	const Block slab = {.address = address, .size = SlabSize};
+	return detail::make_block_slab(slab, class_size(sizeClass), ClassAlignment(sizeClass), sizeClass);
+}
+
+void SlabAllocator::release_slab(BlockSlab* slab) noexcept
+{
+	slab->next = m_freeSlabs;
+	m_freeSlabs = slab;
+}
+
+void SlabAllocator::free_to_slab(BlockSlab* slab, void* ptr) noexcept
+{
+	assert(slab->live > 0 && "Freeing to a slab with no live chunks");
+
+	slab->chunks.free(ptr);
+	if (slab->live-- == slab->capacity)
+	{
+		detail::link_slab(m_available[slab->sizeClass], slab);
+	}
+
+	// Keep one empty slab per class so a class hovering around a slab
+	// boundary doesn't keep rebuilding it
+	if (slab->live == 0 && (slab->prev || slab->next))
+	{
+		detail::unlink_slab(m_available[slab->sizeClass], slab);
+		release_slab(slab);
+	}
+}
+
+auto SlabAllocator::owns_address(uintptr_t address) const noexcept -> bool
+{
+	return is_address_in_range(address, m_baseAddress, m_slabCount * SlabSize);
+}
+
+}
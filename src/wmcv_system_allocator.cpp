@@ -0,0 +1,47 @@
+#include "pch.h"
+
+#include "wmcv_system_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+auto SystemAllocator::allocate(size_t size) noexcept -> Block
+{
+	constexpr size_t s_default_alignment = 16;
+	return allocate_aligned(size, s_default_alignment);
+}
+
+auto SystemAllocator::allocate_aligned(size_t size, size_t alignment) noexcept -> Block
+{
+	assert(is_power_of_two(alignment));
+
+	if (size == 0)
+	{
+		return NullBlock();
+	}
+
+#ifdef _WIN32
+	void* ptr = _aligned_malloc(size, alignment);
+#else
+	void* ptr = std::aligned_alloc(alignment, align(uintptr_t{size}, alignment));
+#endif
+
+	if (ptr == nullptr)
+	{
+		return NullBlock();
+	}
+
+	return { .address = ptr_to_address(ptr), .size = size };
+}
+
+void SystemAllocator::free(void* ptr) noexcept
+{
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+} // namespace wmcv
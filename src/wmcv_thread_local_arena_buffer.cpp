@@ -0,0 +1,88 @@
+#include "pch.h"
+
+#include "wmcv_thread_local_arena_buffer.h"
+#include "wmcv_lockless_arena_allocator.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+ThreadLocalArenaBuffer::ThreadLocalArenaBuffer(LocklessArenaAllocator& arena, size_t bufferSize) noexcept
+	: m_arena(arena)
+	, m_bufferSize(bufferSize)
+	, m_epoch(arena.epoch())
+	, m_cursor(0)
+	, m_end(0)
+{
+	assert(m_bufferSize > 0 && "Buffer size must be non-zero");
+}
+
+auto ThreadLocalArenaBuffer::allocate(size_t size) noexcept -> Block
+{
+	constexpr size_t s_default_alignment = 16;
+	return allocate_aligned(size, s_default_alignment);
+}
+
+auto ThreadLocalArenaBuffer::allocate_aligned(size_t size, size_t alignment) noexcept -> Block
+{
+	if (const size_t epoch = m_arena.epoch(); epoch != m_epoch)
+	{
+		m_epoch = epoch;
+		release();
+	}
+
+	if (size > m_bufferSize / 2)
+	{
+		return m_arena.allocate_aligned(size, alignment);
+	}
+
+	uintptr_t address = align(m_cursor, alignment);
+	if (m_cursor == 0 || address + size > m_end)
+	{
+		if (!refill())
+		{
+			return m_arena.allocate_aligned(size, alignment);
+		}
+
+		address = align(m_cursor, alignment);
+		if (address + size > m_end)
+		{
+			return m_arena.allocate_aligned(size, alignment);
+		}
+	}
+
+	m_cursor = address + size;
+	return { .address = address, .size = size };
+}
+
+void ThreadLocalArenaBuffer::free(void*) noexcept
+{
+}
+
+void ThreadLocalArenaBuffer::release() noexcept
+{
+	m_cursor = 0;
+	m_end = 0;
+}
+
+auto ThreadLocalArenaBuffer::remaining() const noexcept -> size_t
+{
+	return m_end - m_cursor;
+}
+
+auto ThreadLocalArenaBuffer::refill() noexcept -> bool
+{
+	// Aligned to the arena's granule so every refill takes its fetch_add path,
+	// an arena built with a granule of CacheLineSize keeps buffers on their own lines
+	const Block block = m_arena.allocate_aligned(m_bufferSize, m_arena.granule());
+	if (block == NullBlock())
+	{
+		return false;
+	}
+
+	m_cursor = block.address;
+	m_end = block.address + block.size;
+	return true;
+}
+
+}
@@ -0,0 +1,115 @@
+#include "pch.h"
+
+#include "wmcv_virtual_arena_allocator.h"
+#include "wmcv_virtual_memory.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+static auto ComputeCommitGranularity(size_t granularity) noexcept -> size_t
+{
+	const size_t page_size = virtual_memory_page_size();
+	if (granularity < page_size)
+	{
+		granularity = page_size;
+	}
+
+	return align(uintptr_t{granularity}, page_size);
+}
+
+VirtualArenaAllocator::VirtualArenaAllocator(size_t reserveSize, size_t commitGranularity) noexcept
+	: m_baseAddress(0llu)
+	, m_size(0llu)
+	, m_commitGranularity(ComputeCommitGranularity(commitGranularity))
+	, m_committed(0llu)
+	, m_marker(0llu)
+{
+	assert(is_power_of_two(m_commitGranularity) && "Commit granularity must be a power of 2");
+
+	const size_t size = align(uintptr_t{reserveSize}, m_commitGranularity);
+	m_baseAddress = virtual_memory_reserve(size);
+	if (m_baseAddress != 0llu)
+	{
+		m_size = size;
+	}
+}
+
+VirtualArenaAllocator::~VirtualArenaAllocator() noexcept
+{
+	if (m_baseAddress != 0llu)
+	{
+		virtual_memory_release(m_baseAddress, m_size);
+	}
+}
+
+auto VirtualArenaAllocator::allocate(size_t size) noexcept -> Block
+{
+	constexpr size_t s_default_alignment = 16;
+	return allocate_aligned(size, s_default_alignment);
+}
+
+auto VirtualArenaAllocator::allocate_aligned(size_t size, size_t alignment) noexcept -> Block
+{
+	const uintptr_t curr_ptr = m_baseAddress + m_marker;
+	const uintptr_t offset = align(curr_ptr, alignment) - m_baseAddress;
+
+	if (offset + size <= m_size)
+	{
+		if (offset + size > m_committed && !commit(offset + size))
+		{
+			return NullBlock();
+		}
+
+		const uintptr_t address = m_baseAddress + offset;
+		m_marker = offset + size;
+		return { .address = address, .size = size };
+	}
+
+	return NullBlock();
+}
+
+void VirtualArenaAllocator::free(void*) noexcept
+{
+}
+
+void VirtualArenaAllocator::reset() noexcept
+{
+	m_marker = 0llu;
+}
+
+void VirtualArenaAllocator::reset(size_t retainSize) noexcept
+{
+	m_marker = 0llu;
+
+	const size_t retained = align(uintptr_t{retainSize}, m_commitGranularity);
+	if (retained < m_committed)
+	{
+		virtual_memory_decommit(m_baseAddress + retained, m_committed - retained);
+		m_committed = retained;
+	}
+}
+
+auto VirtualArenaAllocator::reserved_size() const noexcept -> size_t
+{
+	return m_size;
+}
+
+auto VirtualArenaAllocator::committed_size() const noexcept -> size_t
+{
+	return m_committed;
+}
+
+auto VirtualArenaAllocator::commit(size_t marker) noexcept -> bool
+{
+	const size_t new_committed = std::min(size_t{align(uintptr_t{marker}, m_commitGranularity)}, m_size);
+	if (!virtual_memory_commit(m_baseAddress + m_committed, new_committed - m_committed))
+	{
+		return false;
+	}
+
+	m_committed = new_committed;
+	return true;
+}
+
+} // namespace wmcv
@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "wmcv_virtual_memory.h"
+#include "wmcv_allocator_utility.h"
+
+namespace wmcv
+{
+
+#ifdef _WIN32
+
+auto virtual_memory_page_size() noexcept -> size_t
+{
+	SYSTEM_INFO info = {};
+	GetSystemInfo(&info);
+	return size_t{info.dwPageSize};
+}
+
+auto virtual_memory_reserve(size_t size) noexcept -> uintptr_t
+{
+	void* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+	return ptr_to_address(ptr);
+}
+
+auto virtual_memory_commit(uintptr_t address, size_t size) noexcept -> bool
+{
+	return VirtualAlloc(address_to_ptr(address), size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void virtual_memory_decommit(uintptr_t address, size_t size) noexcept
+{
+	VirtualFree(address_to_ptr(address), size, MEM_DECOMMIT);
+}
+
+void virtual_memory_release(uintptr_t address, size_t) noexcept
+{
+	VirtualFree(address_to_ptr(address), 0, MEM_RELEASE);
+}
+
+#else
+
+auto virtual_memory_page_size() noexcept -> size_t
+{
+	const long page_size = sysconf(_SC_PAGESIZE);
+	return page_size > 0 ? static_cast<size_t>(page_size) : size_t{4096};
+}
+
+auto virtual_memory_reserve(size_t size) noexcept -> uintptr_t
+{
+	void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (ptr == MAP_FAILED)
+	{
+		return uintptr_t{0};
+	}
+
+	return ptr_to_address(ptr);
+}
+
+auto virtual_memory_commit(uintptr_t address, size_t size) noexcept -> bool
+{
+	return mprotect(address_to_ptr(address), size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void virtual_memory_decommit(uintptr_t address, size_t size) noexcept
+{
+	// MADV_DONTNEED drops the physical pages so RSS goes down straight away,
+	// PROT_NONE makes any stale access past the committed range fault
+	madvise(address_to_ptr(address), size, MADV_DONTNEED);
+	mprotect(address_to_ptr(address), size, PROT_NONE);
+}
+
+void virtual_memory_release(uintptr_t address, size_t size) noexcept
+{
+	munmap(address_to_ptr(address), size);
+}
+
+#endif
+
+} // namespace wmcv
@@ -0,0 +1,16 @@
+#ifndef WMCV_VIRTUAL_MEMORY_H_INCLUDED
+#define WMCV_VIRTUAL_MEMORY_H_INCLUDED
+
+namespace wmcv
+{
+
+[[nodiscard]] auto virtual_memory_page_size() noexcept -> size_t;
+
+[[nodiscard]] auto virtual_memory_reserve(size_t size) noexcept -> uintptr_t;
+[[nodiscard]] auto virtual_memory_commit(uintptr_t address, size_t size) noexcept -> bool;
+void virtual_memory_decommit(uintptr_t address, size_t size) noexcept;
+void virtual_memory_release(uintptr_t address, size_t size) noexcept;
+
+}
+
+#endif //WMCV_VIRTUAL_MEMORY_H_INCLUDED
@@ -1,6 +1,7 @@
 #include "test_pch.h"
 
 #include "wmcv_memory/wmcv_arena_allocator.h"
+#include "wmcv_memory/wmcv_arena_scope.h"
 #include "wmcv_memory/wmcv_allocator_utility.h"
 
 TEST(test_arena_allocator, test_allocator_alloc)
@@ -59,4 +60,289 @@ TEST(test_arena_allocator, test_allocator_clear)
 
 	block = arena.allocate(size);
 	EXPECT_NE(block, wmcv::NullBlock());
-}
\ No newline at end of file
+}
+
+TEST(test_arena_allocator, test_allocator_rewind_to_marker)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::ArenaAllocator arena(mem);
+
+	auto first = arena.allocate(1_kB);
+	EXPECT_NE(first, wmcv::NullBlock());
+
+	const auto marker = arena.get_marker();
+
+	auto scratch = arena.allocate(2_kB);
+	EXPECT_NE(scratch, wmcv::NullBlock());
+
+	arena.rewind(marker);
+	EXPECT_EQ(arena.get_marker(), marker);
+
+	auto result = arena.allocate(2_kB);
+	EXPECT_EQ(result, scratch);
+}
+
+TEST(test_arena_allocator, test_allocator_scope)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::ArenaAllocator arena(mem);
+
+	auto first = arena.allocate(1_kB);
+	EXPECT_NE(first, wmcv::NullBlock());
+
+	const auto marker = arena.get_marker();
+
+	{
+		wmcv::ArenaScope scope(arena);
+		auto outer = arena.allocate(1_kB);
+		EXPECT_NE(outer, wmcv::NullBlock());
+
+		{
+			wmcv::ArenaScope nested(arena);
+			auto inner = arena.allocate(2_kB);
+			EXPECT_NE(inner, wmcv::NullBlock());
+		}
+
+		auto result = arena.allocate(2_kB);
+		EXPECT_NE(result, wmcv::NullBlock());
+	}
+
+	EXPECT_EQ(arena.get_marker(), marker);
+}
+
+TEST(test_arena_allocator, test_allocator_expand_last_allocation)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::ArenaAllocator arena(mem);
+
+	auto block = arena.allocate(256);
+	auto expanded = arena.try_expand(block, 1_kB);
+	EXPECT_EQ(expanded.address, block.address);
+	EXPECT_EQ(expanded.size, 1_kB);
+	EXPECT_EQ(arena.get_marker(), 1_kB);
+
+	EXPECT_EQ(arena.try_expand(expanded, 8_kB), wmcv::NullBlock());
+	EXPECT_EQ(arena.get_marker(), 1_kB);
+}
+
+TEST(test_arena_allocator, test_allocator_expand_fails_when_not_last)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::ArenaAllocator arena(mem);
+
+	auto first = arena.allocate(256);
+	auto second = arena.allocate(256);
+	const auto marker = arena.get_marker();
+
+	EXPECT_EQ(arena.try_expand(first, 512), wmcv::NullBlock());
+	EXPECT_EQ(arena.shrink(first, 128), wmcv::NullBlock());
+	EXPECT_EQ(arena.get_marker(), marker);
+
+	auto shrunk = arena.shrink(second, 64);
+	EXPECT_EQ(shrunk.address, second.address);
+	EXPECT_EQ(shrunk.size, 64);
+	EXPECT_EQ(arena.get_marker(), 256 + 64);
+}
+
+TEST(test_arena_allocator, test_allocator_reallocate)
+{
+	std::array<std::byte, 4_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	auto first = arena.allocate(64);
+	std::memset(wmcv::address_to_ptr(first.address), 0xab, first.size);
+
+	auto grown = arena.reallocate(first, 128);
+	EXPECT_EQ(grown.address, first.address);
+	EXPECT_EQ(grown.size, 128);
+
+	auto second = arena.allocate(64);
+	EXPECT_NE(second, wmcv::NullBlock());
+
+	auto moved = arena.reallocate(grown, 256);
+	EXPECT_NE(moved, wmcv::NullBlock());
+	EXPECT_NE(moved.address, grown.address);
+	EXPECT_EQ(moved.size, 256);
+	EXPECT_EQ(*static_cast<std::byte*>(wmcv::address_to_ptr(moved.address + 63)), std::byte{0xab});
+
+	auto smaller = arena.reallocate(second, 32);
+	EXPECT_EQ(smaller.address, second.address);
+	EXPECT_EQ(smaller.size, 32);
+
+	EXPECT_EQ(arena.reallocate(moved, 8_kB), wmcv::NullBlock());
+}
+
+TEST(test_arena_allocator, test_allocator_reallocate_to_stricter_alignment)
+{
+	alignas(256) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	(void)arena.allocate(16);
+	auto tail = arena.allocate(64);
+	ASSERT_FALSE(wmcv::is_aligned(tail.address, 256));
+	std::memset(wmcv::address_to_ptr(tail.address), 0xcd, tail.size);
+
+	// the tail could grow or shrink in place but not at the alignment asked for
+	auto grown = arena.reallocate_aligned(tail, 128, 256);
+	EXPECT_TRUE(wmcv::is_aligned(grown.address, 256));
+	EXPECT_EQ(grown.size, 128);
+	EXPECT_EQ(*static_cast<std::byte*>(wmcv::address_to_ptr(grown.address + 63)), std::byte{0xcd});
+
+	auto tail2 = arena.allocate(64);
+	ASSERT_FALSE(wmcv::is_aligned(tail2.address, 256));
+	auto shrunk = arena.reallocate_aligned(tail2, 32, 256);
+	EXPECT_TRUE(wmcv::is_aligned(shrunk.address, 256));
+	EXPECT_EQ(shrunk.size, 32);
+}
+
+namespace
+{
+	struct DestructionLog
+	{
+		std::vector<int> order;
+	};
+
+	struct Tracked
+	{
+		Tracked(DestructionLog& destructionLog, int trackedId) noexcept
+			: log(destructionLog)
+			, id(trackedId)
+		{
+		}
+
+		~Tracked()
+		{
+			log.order.push_back(id);
+		}
+
+		DestructionLog& log;
+		int id;
+	};
+}
+
+TEST(test_arena_allocator, test_allocator_create_trivial)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	auto* value = arena.create<double>(4.0);
+	EXPECT_NE(value, nullptr);
+	EXPECT_EQ(*value, 4.0);
+	EXPECT_EQ(arena.get_marker(), sizeof(double));
+}
+
+TEST(test_arena_allocator, test_allocator_create_runs_destructors_on_reset)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	DestructionLog log;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		auto* tracked = arena.create<Tracked>(log, i);
+		EXPECT_NE(tracked, nullptr);
+		EXPECT_EQ(tracked->id, i);
+	}
+
+	EXPECT_TRUE(log.order.empty());
+
+	arena.reset();
+	EXPECT_EQ(log.order, (std::vector<int>{2, 1, 0}));
+
+	arena.reset();
+	EXPECT_EQ(log.order.size(), 3);
+}
+
+TEST(test_arena_allocator, test_allocator_create_runs_destructors_on_rewind)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	DestructionLog log;
+
+	(void)arena.create<Tracked>(log, 0);
+
+	{
+		wmcv::ArenaScope scope(arena);
+		(void)arena.create<Tracked>(log, 1);
+		(void)arena.create<Tracked>(log, 2);
+	}
+
+	EXPECT_EQ(log.order, (std::vector<int>{2, 1}));
+
+	arena.reset();
+	EXPECT_EQ(log.order, (std::vector<int>{2, 1, 0}));
+}
+
+TEST(test_arena_allocator, test_allocator_create_runs_destructors_on_shrink)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	DestructionLog log;
+
+	(void)arena.create<Tracked>(log, 0);
+	const auto start = arena.get_marker();
+	(void)arena.create<Tracked>(log, 1);
+	(void)arena.create<Tracked>(log, 2);
+
+	// everything created since start, shrunk back to nothing
+	const wmcv::Block region = {.address = wmcv::ptr_to_address(buffer.data()) + start, .size = arena.get_marker() - start};
+	EXPECT_NE(arena.shrink(region, 0), wmcv::NullBlock());
+	EXPECT_EQ(arena.get_marker(), start);
+	EXPECT_EQ(log.order, (std::vector<int>{2, 1}));
+
+	arena.reset();
+	EXPECT_EQ(log.order, (std::vector<int>{2, 1, 0}));
+}
+
+TEST(test_arena_allocator, test_allocator_create_runs_destructors_on_destruction)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	DestructionLog log;
+
+	{
+		wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+		(void)arena.create<Tracked>(log, 0);
+		(void)arena.create<std::vector<int>>(size_t{128}, 7);
+	}
+
+	EXPECT_EQ(log.order, (std::vector<int>{0}));
+}
+
+TEST(test_arena_allocator, test_allocator_create_too_large)
+{
+	alignas(16) std::array<std::byte, 64> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	auto* value = arena.create<std::array<std::byte, 128>>();
+	EXPECT_EQ(value, nullptr);
+}
+
+TEST(test_arena_allocator, test_allocator_allocate_n)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::ArenaAllocator arena(mem);
+
+	std::array<wmcv::Block, 8> blocks = {};
+	EXPECT_EQ(arena.allocate_n(blocks.size(), 24, 16, blocks), blocks.size());
+
+	for (size_t i = 0; i < blocks.size(); ++i)
+	{
+		EXPECT_EQ(blocks[i].address, 0x00040000 + i * 32);
+		EXPECT_EQ(blocks[i].size, 24);
+	}
+
+	EXPECT_EQ(arena.get_marker(), 7 * 32 + 24);
+}
+
+TEST(test_arena_allocator, test_allocator_allocate_n_all_or_nothing)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 1_kB};
+	wmcv::ArenaAllocator arena(mem);
+
+	std::array<wmcv::Block, 16> blocks = {};
+	EXPECT_EQ(arena.allocate_n(blocks.size(), 128, 16, blocks), 0);
+	EXPECT_EQ(arena.get_marker(), 0);
+
+	EXPECT_EQ(arena.allocate_n(8, 128, 16, blocks), 8);
+	EXPECT_EQ(arena.get_marker(), 1_kB);
+}
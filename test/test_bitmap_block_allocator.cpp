@@ -0,0 +1,120 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_bitmap_block_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+TEST(test_bitmap_block_allocator, test_allocator_alloc)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BitmapBlockAllocator pool(mem, 32, 16);
+
+	auto result = pool.allocate();
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.size, 32);
+	EXPECT_TRUE(wmcv::is_aligned(result.address, 16));
+	EXPECT_TRUE(wmcv::is_address_in_range(result.address, mem.address, mem.size));
+}
+
+TEST(test_bitmap_block_allocator, test_allocator_bitmap_and_chunks_fit)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BitmapBlockAllocator pool(mem, 32, 16);
+
+	// 4 KiB holds 127 chunks of 32 bytes once the bitmap and its padding take their share
+	EXPECT_EQ(pool.chunk_count(), 127);
+
+	for (size_t i = 0; i < pool.chunk_count(); ++i)
+	{
+		auto result = pool.allocate();
+		ASSERT_NE(result, wmcv::NullBlock());
+		ASSERT_LE(result.address + result.size, mem.address + mem.size);
+	}
+
+	EXPECT_EQ(pool.allocate(), wmcv::NullBlock());
+}
+
+TEST(test_bitmap_block_allocator, test_allocator_alloc_lowest_free_chunk)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BitmapBlockAllocator pool(mem, 16, 16);
+
+	std::vector<wmcv::Block> blocks;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		blocks.push_back(pool.allocate());
+	}
+
+	pool.free(wmcv::address_to_ptr(blocks[70].address));
+	pool.free(wmcv::address_to_ptr(blocks[5].address));
+
+	EXPECT_EQ(pool.allocate(), blocks[5]);
+	EXPECT_EQ(pool.allocate(), blocks[70]);
+	EXPECT_EQ(pool.allocate().address, blocks[99].address + 16);
+}
+
+TEST(test_bitmap_block_allocator, test_allocator_free_doesnt_touch_chunk)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BitmapBlockAllocator pool(mem, 32, 16);
+
+	auto result = pool.allocate();
+	std::memset(wmcv::address_to_ptr(result.address), 0xab, result.size);
+	pool.free(wmcv::address_to_ptr(result.address));
+
+	const auto* bytes = static_cast<const std::byte*>(wmcv::address_to_ptr(result.address));
+	EXPECT_TRUE(std::all_of(bytes, bytes + result.size, [](std::byte b) { return b == std::byte{0xab}; }));
+}
+
+TEST(test_bitmap_block_allocator, test_allocator_for_each_live_in_address_order)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BitmapBlockAllocator pool(mem, 16, 16);
+
+	std::vector<wmcv::Block> blocks;
+	for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+	{
+		blocks.push_back(block);
+	}
+
+	std::vector<wmcv::Block> expected;
+	for (size_t i = 0; i < blocks.size(); ++i)
+	{
+		if (i % 3 == 0)
+		{
+			expected.push_back(blocks[i]);
+		}
+		else
+		{
+			pool.free(wmcv::address_to_ptr(blocks[i].address));
+		}
+	}
+
+	std::vector<wmcv::Block> visited;
+	pool.for_each([&](wmcv::Block block) { visited.push_back(block); });
+
+	EXPECT_EQ(visited, expected);
+	EXPECT_EQ(pool.live_count(), expected.size());
+}
+
+TEST(test_bitmap_block_allocator, test_allocator_reset)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BitmapBlockAllocator pool(mem, 32, 16);
+
+	auto first = pool.allocate();
+	while (pool.allocate() != wmcv::NullBlock())
+	{
+	}
+
+	pool.reset();
+	EXPECT_EQ(pool.live_count(), 0);
+
+	auto second = pool.allocate();
+	EXPECT_EQ(first, second);
+}
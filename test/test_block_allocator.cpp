@@ -52,4 +52,152 @@ TEST(test_block_allocator, test_allocator_clear)
 
 	block = pool.allocate();
 	EXPECT_NE(block, wmcv::NullBlock());
-}
\ No newline at end of file
+}
+TEST(test_block_allocator, test_allocator_allocate_n)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BlockAllocator pool(mem, 64, 16);
+
+	std::array<wmcv::Block, 12> blocks = {};
+	EXPECT_EQ(pool.allocate_n(blocks.size(), blocks), blocks.size());
+
+	std::sort(blocks.begin(), blocks.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+	for (size_t i = 1; i < blocks.size(); ++i)
+	{
+		EXPECT_EQ(blocks[i].size, 64);
+		EXPECT_NE(blocks[i - 1].address, blocks[i].address);
+	}
+
+	// only 4 chunks left
+	EXPECT_EQ(pool.allocate_n(blocks.size(), blocks), 4);
+	EXPECT_EQ(pool.allocate(), wmcv::NullBlock());
+
+	pool.free(wmcv::address_to_ptr(blocks[0].address));
+	EXPECT_EQ(pool.allocate_n(blocks.size(), blocks), 1);
+}
+
+TEST(test_block_allocator, test_allocator_construct_does_not_touch_memory)
+{
+	// never dereferenced, chunks are only carved on allocation
+	wmcv::Block mem{.address = 0x00040000, .size = 1_GB};
+	wmcv::BlockAllocator pool(mem, 64, 16);
+
+	auto result = pool.allocate();
+	EXPECT_EQ(result.address, 0x00040000);
+
+	result = pool.allocate();
+	EXPECT_EQ(result.address, 0x00040000 + 64);
+
+	pool.reset();
+
+	result = pool.allocate();
+	EXPECT_EQ(result.address, 0x00040000);
+}
+
+TEST(test_block_allocator, test_allocator_reset_restores_every_chunk_once)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BlockAllocator pool(mem, 64, 16);
+
+	for (size_t round = 0; round < 2; ++round)
+	{
+		std::vector<wmcv::Block> blocks;
+		for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+		{
+			blocks.push_back(block);
+		}
+
+		EXPECT_EQ(blocks.size(), buffer.size() / 64);
+
+		pool.free(wmcv::address_to_ptr(blocks[3].address));
+		pool.free(wmcv::address_to_ptr(blocks[7].address));
+		pool.reset();
+	}
+}
+
+TEST(test_block_allocator, test_allocator_alloc_ascending_after_reset)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BlockAllocator pool(mem, 64, 16);
+
+	for (size_t round = 0; round < 2; ++round)
+	{
+		uintptr_t previous = 0;
+		for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+		{
+			EXPECT_GT(block.address, previous);
+			previous = block.address;
+		}
+		pool.reset();
+	}
+}
+
+TEST(test_block_allocator, test_allocator_sort_free_list)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BlockAllocator pool(mem, 32, 16);
+
+	std::vector<wmcv::Block> blocks;
+	for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+	{
+		blocks.push_back(block);
+	}
+
+	// free every other chunk, out of order
+	std::vector<wmcv::Block> freed;
+	for (size_t i = 0; i < blocks.size(); i += 2)
+	{
+		freed.push_back(blocks[i]);
+	}
+
+	std::vector<wmcv::Block> scrambled = freed;
+	std::reverse(scrambled.begin(), scrambled.end());
+	std::rotate(scrambled.begin(), scrambled.begin() + 5, scrambled.end());
+	for (const auto& block : scrambled)
+	{
+		pool.free(wmcv::address_to_ptr(block.address));
+	}
+
+	pool.sort_free_list();
+
+	for (const auto& block : freed)
+	{
+		EXPECT_EQ(pool.allocate(), block);
+	}
+	EXPECT_EQ(pool.allocate(), wmcv::NullBlock());
+}
+
+TEST(test_block_allocator, test_allocator_free_does_not_sort)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::BlockAllocator pool(mem, 64, 16);
+
+	std::vector<wmcv::Block> blocks;
+	for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+	{
+		blocks.push_back(block);
+	}
+
+	for (size_t i : {9u, 2u, 12u, 5u})
+	{
+		pool.free(wmcv::address_to_ptr(blocks[i].address));
+	}
+	EXPECT_EQ(pool.frees_since_sort(), 4);
+
+	// free stays O(1), the list is only sorted when asked
+	EXPECT_EQ(pool.allocate(), blocks[5]);
+	pool.free(wmcv::address_to_ptr(blocks[5].address));
+
+	pool.sort_free_list();
+	EXPECT_EQ(pool.frees_since_sort(), 0);
+
+	for (size_t i : {2u, 5u, 9u, 12u})
+	{
+		EXPECT_EQ(pool.allocate(), blocks[i]);
+	}
+}
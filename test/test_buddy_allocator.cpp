@@ -368,3 +368,214 @@ TEST(test_buddy_allocator, test_allocator_alloc_and_free_typical_use_case)
 	block_5 = buddy.allocate(alloc_sizes[4]);
 	EXPECT_NE(block_5, wmcv::NullBlock());
 }
+
+TEST(test_buddy_allocator, test_allocator_payload_does_not_overlap_buddy)
+{
+	alignas(16) std::array<std::byte, 512> memory = {};
+	const size_t alignment = 16;
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::BuddyAllocator buddy(mem, alignment);
+
+	const auto block_1 = buddy.allocate(24);
+	EXPECT_NE(block_1, wmcv::NullBlock());
+	std::memset(wmcv::address_to_ptr(block_1.address), 0xff, block_1.size);
+
+	const auto block_2 = buddy.allocate(24);
+	EXPECT_NE(block_2, wmcv::NullBlock());
+	EXPECT_GE(block_2.address, block_1.address + block_1.size);
+
+	buddy.free(wmcv::address_to_ptr(block_2.address));
+	buddy.free(wmcv::address_to_ptr(block_1.address));
+
+	const auto block_3 = buddy.allocate(memory.size() - alignment);
+	EXPECT_NE(block_3, wmcv::NullBlock());
+}
+
+TEST(test_buddy_allocator, test_allocator_alloc_uses_smallest_free_block)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	const size_t alignment = 16;
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::BuddyAllocator buddy(mem, alignment);
+
+	// splitting for the first allocation leaves free blocks of 256, 512, 1024 and 2048 bytes
+	const auto small = buddy.allocate(200);
+	EXPECT_NE(small, wmcv::NullBlock());
+
+	const auto medium = buddy.allocate(400);
+	EXPECT_NE(medium, wmcv::NullBlock());
+	EXPECT_EQ(medium.address, small.address + 512);
+
+	// the 256 byte block next to the first allocation is the best fit
+	const auto tiny = buddy.allocate(100);
+	EXPECT_NE(tiny, wmcv::NullBlock());
+	EXPECT_EQ(tiny.address, small.address + 256);
+
+	const auto large = buddy.allocate(2_kB - alignment);
+	EXPECT_NE(large, wmcv::NullBlock());
+	EXPECT_EQ(large.address, small.address + 2_kB);
+}
+
+TEST(test_buddy_allocator, test_allocator_free_merges_buddies)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	const size_t alignment = 16;
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::BuddyAllocator buddy(mem, alignment);
+
+	std::vector<wmcv::Block> blocks;
+	for (auto block = buddy.allocate(alignment); block != wmcv::NullBlock(); block = buddy.allocate(alignment))
+	{
+		blocks.push_back(block);
+	}
+	EXPECT_EQ(blocks.size(), memory.size() / (2 * alignment));
+
+	// none of the left halves can merge until their right halves come back
+	for (size_t i = 0; i < blocks.size(); i += 2)
+	{
+		buddy.free(wmcv::address_to_ptr(blocks[i].address));
+	}
+
+	for (size_t i = blocks.size() - 1; i < blocks.size(); i -= 2)
+	{
+		buddy.free(wmcv::address_to_ptr(blocks[i].address));
+	}
+
+	const auto whole = buddy.allocate(memory.size() - alignment);
+	EXPECT_NE(whole, wmcv::NullBlock());
+	EXPECT_EQ(whole.address, mem.address + alignment);
+}
+
+TEST(test_buddy_allocator, test_allocator_metadata_power_of_two_takes_exact_block)
+{
+	alignas(16) std::array<std::byte, 16_kB> memory = {};
+	const size_t alignment = 16;
+	std::array<uint8_t, wmcv::BuddyAllocator::metadata_size(16_kB, alignment)> metadata = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::Block meta{.address = wmcv::ptr_to_address(metadata.data()), .size = metadata.size()};
+	wmcv::BuddyAllocator buddy(mem, meta, alignment);
+
+	// without headers four 4 KiB requests fill the heap exactly
+	std::array<wmcv::Block, 4> blocks = {};
+	for (auto& block : blocks)
+	{
+		block = buddy.allocate(4_kB);
+		ASSERT_NE(block, wmcv::NullBlock());
+		EXPECT_EQ((block.address - mem.address) % 4_kB, 0u);
+	}
+	EXPECT_EQ(buddy.allocate(alignment), wmcv::NullBlock());
+
+	for (const auto& block : blocks)
+	{
+		buddy.free(wmcv::address_to_ptr(block.address));
+	}
+
+	const auto whole = buddy.allocate(memory.size());
+	EXPECT_NE(whole, wmcv::NullBlock());
+	EXPECT_EQ(whole.address, mem.address);
+}
+
+TEST(test_buddy_allocator, test_allocator_metadata_free_merges_buddies)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	const size_t alignment = 16;
+	std::array<uint8_t, wmcv::BuddyAllocator::metadata_size(4_kB, alignment)> metadata = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::Block meta{.address = wmcv::ptr_to_address(metadata.data()), .size = metadata.size()};
+	wmcv::BuddyAllocator buddy(mem, meta, alignment);
+
+	std::vector<wmcv::Block> blocks;
+	for (auto block = buddy.allocate(alignment); block != wmcv::NullBlock(); block = buddy.allocate(alignment))
+	{
+		EXPECT_EQ(block.address % alignment, 0u);
+		blocks.push_back(block);
+	}
+	EXPECT_EQ(blocks.size(), memory.size() / alignment);
+
+	for (size_t i = 0; i < blocks.size(); i += 2)
+	{
+		buddy.free(wmcv::address_to_ptr(blocks[i].address));
+	}
+
+	// only the left halves are free, nothing bigger than a single unit fits
+	EXPECT_EQ(buddy.allocate(2 * alignment), wmcv::NullBlock());
+
+	for (size_t i = blocks.size() - 1; i < blocks.size(); i -= 2)
+	{
+		buddy.free(wmcv::address_to_ptr(blocks[i].address));
+	}
+
+	const auto whole = buddy.allocate(memory.size());
+	EXPECT_NE(whole, wmcv::NullBlock());
+	EXPECT_EQ(whole.address, mem.address);
+}
+
+TEST(test_buddy_allocator, test_allocator_reallocate_grows_into_free_buddy)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	const size_t alignment = 16;
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::BuddyAllocator buddy(mem, alignment);
+
+	const auto block = buddy.allocate(alignment);
+	ASSERT_NE(block, wmcv::NullBlock());
+	std::memset(wmcv::address_to_ptr(block.address), 0xab, block.size);
+
+	const auto grown = buddy.reallocate(block, 1_kB);
+	EXPECT_EQ(grown.address, block.address);
+	EXPECT_EQ(grown.size, 1_kB);
+	EXPECT_EQ(*static_cast<std::byte*>(wmcv::address_to_ptr(grown.address)), std::byte{0xab});
+
+	// the grown block took a 2 KiB block, the other half is still free
+	const auto other = buddy.allocate(1_kB);
+	EXPECT_EQ(other.address, mem.address + 2_kB + alignment);
+	EXPECT_EQ(buddy.allocate(alignment), wmcv::NullBlock());
+}
+
+TEST(test_buddy_allocator, test_allocator_reallocate_shrink_releases_upper_halves)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	const size_t alignment = 16;
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::BuddyAllocator buddy(mem, alignment);
+
+	const auto block = buddy.allocate(memory.size() - alignment);
+	ASSERT_NE(block, wmcv::NullBlock());
+
+	const auto shrunk = buddy.reallocate(block, alignment);
+	EXPECT_EQ(shrunk.address, block.address);
+	EXPECT_EQ(shrunk.size, alignment);
+
+	const auto upper = buddy.allocate(2_kB - alignment);
+	EXPECT_EQ(upper.address, mem.address + 2_kB + alignment);
+
+	buddy.free(wmcv::address_to_ptr(upper.address));
+	buddy.free(wmcv::address_to_ptr(shrunk.address));
+	EXPECT_NE(buddy.allocate(memory.size() - alignment), wmcv::NullBlock());
+}
+
+TEST(test_buddy_allocator, test_allocator_reallocate_copies_when_buddy_is_taken)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	const size_t alignment = 16;
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::BuddyAllocator buddy(mem, alignment);
+
+	const auto block = buddy.allocate(alignment);
+	const auto neighbour = buddy.allocate(alignment);
+	ASSERT_NE(block, wmcv::NullBlock());
+	ASSERT_NE(neighbour, wmcv::NullBlock());
+	std::memset(wmcv::address_to_ptr(block.address), 0xcd, block.size);
+
+	const auto moved = buddy.reallocate(block, 256);
+	ASSERT_NE(moved, wmcv::NullBlock());
+	EXPECT_NE(moved.address, block.address);
+	EXPECT_EQ(*static_cast<std::byte*>(wmcv::address_to_ptr(moved.address)), std::byte{0xcd});
+
+	// the old block went back to the heap
+	EXPECT_EQ(buddy.allocate(alignment).address, block.address);
+
+	// too big for the heap fails and leaves the block where it was
+	EXPECT_EQ(buddy.reallocate(moved, memory.size()), wmcv::NullBlock());
+	EXPECT_EQ(*static_cast<std::byte*>(wmcv::address_to_ptr(moved.address)), std::byte{0xcd});
+}
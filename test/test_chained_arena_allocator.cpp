@@ -0,0 +1,128 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_chained_arena_allocator.h"
+#include "wmcv_memory/wmcv_arena_allocator.h"
+#include "wmcv_memory/wmcv_system_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	struct CountingAllocator
+	{
+		auto allocate(size_t size) noexcept -> wmcv::Block
+		{
+			++live;
+			return system.allocate(size);
+		}
+
+		void free(void* ptr) noexcept
+		{
+			--live;
+			system.free(ptr);
+		}
+
+		wmcv::SystemAllocator system;
+		size_t live = 0;
+	};
+}
+
+TEST(test_chained_arena_allocator, test_allocator_alloc)
+{
+	wmcv::SystemAllocator system;
+	wmcv::ChainedArenaAllocator arena(system, 4_kB);
+
+	auto result = arena.allocate(1_kB);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.size, 1_kB);
+	EXPECT_EQ(arena.chunk_count(), 1);
+}
+
+TEST(test_chained_arena_allocator, test_allocator_alloc_aligned)
+{
+	wmcv::SystemAllocator system;
+	wmcv::ChainedArenaAllocator arena(system, 4_kB);
+
+	constexpr size_t alignment = 128;
+	constexpr size_t size = 64;
+
+	auto result = arena.allocate_aligned(size, alignment);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_TRUE(wmcv::is_aligned(result.address, alignment));
+
+	result = arena.allocate_aligned(size, alignment);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_TRUE(wmcv::is_aligned(result.address, alignment));
+}
+
+TEST(test_chained_arena_allocator, test_allocator_grows_when_full)
+{
+	wmcv::SystemAllocator system;
+	wmcv::ChainedArenaAllocator arena(system, 4_kB);
+
+	for (size_t i = 0; i < 16; ++i)
+	{
+		auto result = arena.allocate(1_kB);
+		EXPECT_NE(result, wmcv::NullBlock());
+		wmcv::zero_memory(wmcv::address_to_ptr(result.address), result.size);
+	}
+
+	// 4kB, 8kB and 16kB chunks hold 3, 7 and 15 allocations of 1kB
+	EXPECT_EQ(arena.chunk_count(), 3);
+}
+
+TEST(test_chained_arena_allocator, test_allocator_alloc_larger_than_chunk)
+{
+	wmcv::SystemAllocator system;
+	wmcv::ChainedArenaAllocator arena(system, 4_kB);
+
+	auto result = arena.allocate(64_kB);
+	EXPECT_NE(result, wmcv::NullBlock());
+	wmcv::zero_memory(wmcv::address_to_ptr(result.address), result.size);
+}
+
+TEST(test_chained_arena_allocator, test_allocator_upstream_exhausted)
+{
+	std::array<std::byte, 4_kB> buffer = {};
+	wmcv::ArenaAllocator upstream({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	wmcv::ChainedArenaAllocator arena(upstream, 1_kB);
+
+	auto result = arena.allocate(512);
+	EXPECT_NE(result, wmcv::NullBlock());
+
+	result = arena.allocate(8_kB);
+	EXPECT_EQ(result, wmcv::NullBlock());
+
+	result = arena.allocate(1_kB);
+	EXPECT_NE(result, wmcv::NullBlock());
+}
+
+TEST(test_chained_arena_allocator, test_allocator_clear_keeps_largest_chunk)
+{
+	CountingAllocator upstream;
+
+	{
+		wmcv::ChainedArenaAllocator arena(upstream, 4_kB);
+
+		for (size_t i = 0; i < 16; ++i)
+		{
+			auto result = arena.allocate(1_kB);
+			EXPECT_NE(result, wmcv::NullBlock());
+		}
+
+		EXPECT_EQ(upstream.live, 3);
+
+		arena.reset();
+		EXPECT_EQ(upstream.live, 1);
+		EXPECT_EQ(arena.chunk_count(), 1);
+
+		for (size_t i = 0; i < 15; ++i)
+		{
+			auto result = arena.allocate(1_kB);
+			EXPECT_NE(result, wmcv::NullBlock());
+		}
+
+		EXPECT_EQ(arena.chunk_count(), 1);
+	}
+
+	EXPECT_EQ(upstream.live, 0);
+}
@@ -0,0 +1,126 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_concurrent_buddy_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+#include "wmcv_memory/wmcv_memory_block.h"
+
+TEST(test_concurrent_buddy_allocator, test_allocator_alloc_and_free)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	const size_t alignment = 16;
+	std::array<uint8_t, wmcv::ConcurrentBuddyAllocator::metadata_size(4_kB, alignment)> metadata = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::Block meta{.address = wmcv::ptr_to_address(metadata.data()), .size = metadata.size()};
+	wmcv::ConcurrentBuddyAllocator buddy(mem, meta, alignment);
+
+	const auto small = buddy.allocate(100);
+	EXPECT_EQ(small.address, mem.address);
+	EXPECT_EQ(small.size, 100u);
+
+	// a power-of-two request takes a block of exactly its size
+	const auto half = buddy.allocate(2_kB);
+	EXPECT_EQ(half.address, mem.address + 2_kB);
+	EXPECT_EQ(buddy.allocate(2_kB), wmcv::NullBlock());
+
+	buddy.free(wmcv::address_to_ptr(small.address));
+	buddy.free(wmcv::address_to_ptr(half.address));
+
+	const auto whole = buddy.allocate(memory.size());
+	EXPECT_EQ(whole.address, mem.address);
+}
+
+TEST(test_concurrent_buddy_allocator, test_allocator_too_large)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	std::array<uint8_t, wmcv::ConcurrentBuddyAllocator::metadata_size(4_kB)> metadata = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::Block meta{.address = wmcv::ptr_to_address(metadata.data()), .size = metadata.size()};
+	wmcv::ConcurrentBuddyAllocator buddy(mem, meta);
+
+	EXPECT_EQ(buddy.allocate(memory.size() + 1), wmcv::NullBlock());
+}
+
+TEST(test_concurrent_buddy_allocator, test_allocator_reset)
+{
+	alignas(16) std::array<std::byte, 4_kB> memory = {};
+	std::array<uint8_t, wmcv::ConcurrentBuddyAllocator::metadata_size(4_kB)> metadata = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::Block meta{.address = wmcv::ptr_to_address(metadata.data()), .size = metadata.size()};
+	wmcv::ConcurrentBuddyAllocator buddy(mem, meta);
+
+	EXPECT_NE(buddy.allocate(1_kB), wmcv::NullBlock());
+	EXPECT_NE(buddy.allocate(1_kB), wmcv::NullBlock());
+	EXPECT_EQ(buddy.allocate(4_kB), wmcv::NullBlock());
+
+	buddy.reset();
+	EXPECT_EQ(buddy.allocate(4_kB).address, mem.address);
+}
+
+TEST(test_concurrent_buddy_allocator, test_allocator_alloc_from_multiple_threads)
+{
+	alignas(64) static std::array<std::byte, 256_kB> memory = {};
+	const size_t alignment = 16;
+	std::vector<uint8_t> metadata(wmcv::ConcurrentBuddyAllocator::metadata_size(memory.size(), alignment));
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::Block meta{.address = wmcv::ptr_to_address(metadata.data()), .size = metadata.size()};
+	wmcv::ConcurrentBuddyAllocator buddy(mem, meta, alignment);
+
+	constexpr size_t thread_count = 4;
+	constexpr std::array<size_t, 4> sizes = { 16u, 100u, 512u, 2000u };
+	std::array<std::vector<wmcv::Block>, thread_count> results;
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&, t]
+		{
+			// churn through every order, then keep whatever can still be allocated
+			std::vector<wmcv::Block> held;
+			for (size_t i = 0; i < 2000; ++i)
+			{
+				if (held.size() == 8)
+				{
+					buddy.free(wmcv::address_to_ptr(held[i % held.size()].address));
+					held.erase(held.begin() + static_cast<std::ptrdiff_t>(i % held.size()));
+				}
+
+				const auto block = buddy.allocate(sizes[(i + t) % sizes.size()]);
+				if (block != wmcv::NullBlock())
+				{
+					std::memset(wmcv::address_to_ptr(block.address), static_cast<int>(t), block.size);
+					held.push_back(block);
+				}
+			}
+
+			for (auto block = buddy.allocate(sizes[t]); block != wmcv::NullBlock(); block = buddy.allocate(sizes[t]))
+			{
+				held.push_back(block);
+			}
+
+			results[t] = std::move(held);
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	std::vector<wmcv::Block> all;
+	for (const auto& blocks : results)
+	{
+		all.insert(all.end(), blocks.begin(), blocks.end());
+	}
+
+	std::sort(all.begin(), all.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+	for (size_t i = 1; i < all.size(); ++i)
+	{
+		EXPECT_GE(all[i].address, all[i - 1].address + all[i - 1].size);
+	}
+
+	for (const auto& block : all)
+	{
+		buddy.free(wmcv::address_to_ptr(block.address));
+	}
+
+	// everything merged back into one block
+	EXPECT_EQ(buddy.allocate(memory.size()).address, mem.address);
+}
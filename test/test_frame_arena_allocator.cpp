@@ -0,0 +1,110 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_frame_arena_allocator.h"
+#include "wmcv_memory/wmcv_arena_allocator.h"
+#include "wmcv_memory/wmcv_lockless_arena_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+TEST(test_frame_arena_allocator, test_allocator_alloc)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::FrameArenaAllocator<wmcv::ArenaAllocator, 2> frames(mem);
+
+	EXPECT_EQ(frames.frame_capacity(), 2_kB);
+
+	auto result = frames.allocate(1_kB);
+	EXPECT_EQ(result.address, 0x00040000);
+	EXPECT_EQ(frames.used(), 1_kB);
+
+	result = frames.allocate(2_kB);
+	EXPECT_EQ(result, wmcv::NullBlock());
+}
+
+TEST(test_frame_arena_allocator, test_allocator_frames_rotate)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 3_kB};
+	wmcv::FrameArenaAllocator<wmcv::ArenaAllocator, 3> frames(mem);
+
+	auto frame_0 = frames.allocate(256);
+	EXPECT_EQ(frame_0.address, 0x00040000);
+
+	frames.advance_frame();
+	auto frame_1 = frames.allocate(256);
+	EXPECT_EQ(frame_1.address, 0x00040000 + 1_kB);
+
+	frames.advance_frame();
+	auto frame_2 = frames.allocate(256);
+	EXPECT_EQ(frame_2.address, 0x00040000 + 2_kB);
+
+	// back to the first buffer, which has been reset
+	frames.advance_frame();
+	EXPECT_EQ(frames.frame(), 3);
+	EXPECT_EQ(frames.used(), 0);
+
+	auto frame_3 = frames.allocate(256);
+	EXPECT_EQ(frame_3.address, frame_0.address);
+}
+
+TEST(test_frame_arena_allocator, test_allocator_advance_keeps_previous_frames)
+{
+	alignas(16) std::array<std::byte, 2_kB> buffer = {};
+	wmcv::FrameArenaAllocator<wmcv::ArenaAllocator, 2> frames({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	auto* previous = frames.create<std::vector<int>>(size_t{4}, 42);
+	frames.advance_frame();
+
+	auto* current = frames.create<std::vector<int>>(size_t{4}, 7);
+	EXPECT_EQ(previous->at(3), 42);
+	EXPECT_EQ(current->at(3), 7);
+
+	frames.advance_frame();
+	EXPECT_EQ(current->at(3), 7);
+}
+
+TEST(test_frame_arena_allocator, test_allocator_high_water_mark)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::FrameArenaAllocator<wmcv::ArenaAllocator, 2> frames(mem);
+
+	(void)frames.allocate(512);
+	frames.advance_frame();
+	(void)frames.allocate(128);
+	frames.advance_frame();
+	(void)frames.allocate(256);
+
+	EXPECT_EQ(frames.high_water_mark(0), 512);
+	EXPECT_EQ(frames.high_water_mark(1), 128);
+	EXPECT_EQ(frames.high_water_mark(), 512);
+
+	(void)frames.allocate(1_kB);
+	EXPECT_EQ(frames.high_water_mark(0), 1280);
+}
+
+TEST(test_frame_arena_allocator, test_allocator_lockless_frames)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 64_kB};
+	wmcv::FrameArenaAllocator<wmcv::LocklessArenaAllocator, 2> frames(mem);
+
+	for (size_t frame = 0; frame < 4; ++frame)
+	{
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			threads.emplace_back([&]
+			{
+				for (size_t j = 0; j < 16; ++j)
+				{
+					EXPECT_NE(frames.allocate(64), wmcv::NullBlock());
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		EXPECT_EQ(frames.used(), 4_kB);
+		frames.advance_frame();
+	}
+
+	EXPECT_EQ(frames.high_water_mark(), 4_kB);
+}
@@ -315,3 +315,18 @@ TEST(test_freelist_best_fit_policy, test_allocator_alloc_and_free_typical_use_ca
 	block_5 = freeList.allocate(alloc_sizes[4]);
 	EXPECT_NE(block_5, wmcv::NullBlock());
 }
+
+TEST(test_freelist_best_fit_policy, test_allocator_free_returns_unsplit_tail)
+{
+	alignas(16) std::array<std::byte, 1_kB> memory = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(memory.data()), .size = memory.size()};
+	wmcv::FreeListBestFitPolicy freeList(mem);
+
+	// leaves a tail too small to become a free node
+	auto block = freeList.allocate(memory.size() - 48);
+	EXPECT_NE(block, wmcv::NullBlock());
+	freeList.free(wmcv::address_to_ptr(block.address));
+
+	block = freeList.allocate(memory.size() - 16);
+	EXPECT_NE(block, wmcv::NullBlock());
+}
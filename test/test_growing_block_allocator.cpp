@@ -0,0 +1,167 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_growing_block_allocator.h"
+#include "wmcv_memory/wmcv_system_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	struct CountingAllocator
+	{
+		auto allocate(size_t size) noexcept -> wmcv::Block
+		{
+			++live;
+			return system.allocate(size);
+		}
+
+		auto allocate_aligned(size_t size, size_t alignment) noexcept -> wmcv::Block
+		{
+			++live;
+			return system.allocate_aligned(size, alignment);
+		}
+
+		void free(void* ptr) noexcept
+		{
+			--live;
+			system.free(ptr);
+		}
+
+		wmcv::SystemAllocator system;
+		size_t live = 0;
+	};
+
+	constexpr size_t s_slab_size = 4_kB;
+	constexpr size_t s_chunk_size = 64;
+	const size_t s_chunks_per_slab = (s_slab_size - wmcv::align(uintptr_t{sizeof(wmcv::BlockSlab)}, 16)) / s_chunk_size;
+
+	auto AllocateSlab(wmcv::GrowingBlockAllocator<CountingAllocator>& pool) -> std::vector<wmcv::Block>
+	{
+		std::vector<wmcv::Block> blocks(s_chunks_per_slab);
+		for (auto& block : blocks)
+		{
+			block = pool.allocate();
+		}
+		return blocks;
+	}
+
+	auto SlabOf(wmcv::Block block) -> uintptr_t
+	{
+		return block.address & ~(s_slab_size - 1);
+	}
+}
+
+TEST(test_growing_block_allocator, test_allocator_alloc)
+{
+	CountingAllocator upstream;
+	wmcv::GrowingBlockAllocator pool(upstream, s_chunk_size, 16, s_slab_size);
+
+	auto result = pool.allocate();
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.size, s_chunk_size);
+	EXPECT_TRUE(wmcv::is_aligned(result.address, 16));
+	EXPECT_EQ(pool.slab_count(), 1);
+	EXPECT_EQ(upstream.live, 1);
+}
+
+TEST(test_growing_block_allocator, test_allocator_grows_on_exhaustion)
+{
+	CountingAllocator upstream;
+	wmcv::GrowingBlockAllocator pool(upstream, s_chunk_size, 16, s_slab_size);
+
+	std::vector<wmcv::Block> blocks;
+	for (size_t i = 0; i < s_chunks_per_slab * 3; ++i)
+	{
+		blocks.push_back(pool.allocate());
+		ASSERT_NE(blocks.back(), wmcv::NullBlock());
+	}
+
+	EXPECT_EQ(pool.slab_count(), 3);
+
+	std::sort(blocks.begin(), blocks.end(), [](auto lhs, auto rhs) { return lhs.address < rhs.address; });
+	EXPECT_TRUE(std::adjacent_find(blocks.begin(), blocks.end()) == blocks.end());
+}
+
+TEST(test_growing_block_allocator, test_allocator_returns_empty_slabs_past_retention)
+{
+	CountingAllocator upstream;
+	wmcv::GrowingBlockAllocator pool(upstream, s_chunk_size, 16, s_slab_size, 1);
+
+	auto first = AllocateSlab(pool);
+	auto second = AllocateSlab(pool);
+	auto third = AllocateSlab(pool);
+	EXPECT_EQ(upstream.live, 3);
+
+	// the first slab to empty is kept, the second goes back upstream
+	for (const auto& block : first)
+	{
+		pool.free(wmcv::address_to_ptr(block.address));
+	}
+	EXPECT_EQ(upstream.live, 3);
+
+	for (const auto& block : second)
+	{
+		pool.free(wmcv::address_to_ptr(block.address));
+	}
+	EXPECT_EQ(upstream.live, 2);
+	EXPECT_EQ(pool.slab_count(), 2);
+
+	// the retained slab is reused before asking upstream again
+	(void)pool.allocate();
+	EXPECT_EQ(upstream.live, 2);
+}
+
+TEST(test_growing_block_allocator, test_allocator_prefers_fullest_slab)
+{
+	CountingAllocator upstream;
+	wmcv::GrowingBlockAllocator pool(upstream, s_chunk_size, 16, s_slab_size);
+
+	auto first = AllocateSlab(pool);
+	auto second = AllocateSlab(pool);
+	auto third = AllocateSlab(pool);
+
+	// first slab nearly empty, second and third (the current one) nearly full
+	for (size_t i = 1; i < first.size(); ++i)
+	{
+		pool.free(wmcv::address_to_ptr(first[i].address));
+	}
+	pool.free(wmcv::address_to_ptr(second[5].address));
+	pool.free(wmcv::address_to_ptr(third[5].address));
+
+	EXPECT_EQ(SlabOf(pool.allocate()), SlabOf(third.front()));
+	EXPECT_EQ(SlabOf(pool.allocate()), SlabOf(second.front()));
+	EXPECT_EQ(SlabOf(pool.allocate()), SlabOf(first.front()));
+	EXPECT_EQ(upstream.live, 3);
+}
+
+TEST(test_growing_block_allocator, test_allocator_reset)
+{
+	CountingAllocator upstream;
+	wmcv::GrowingBlockAllocator pool(upstream, s_chunk_size, 16, s_slab_size, 1);
+
+	for (size_t i = 0; i < 200; ++i)
+	{
+		(void)pool.allocate();
+	}
+	EXPECT_EQ(pool.slab_count(), 4);
+
+	pool.reset();
+	EXPECT_EQ(pool.slab_count(), 1);
+	EXPECT_EQ(upstream.live, 1);
+
+	(void)pool.allocate();
+	EXPECT_EQ(upstream.live, 1);
+}
+
+TEST(test_growing_block_allocator, test_allocator_destructor_returns_slabs)
+{
+	CountingAllocator upstream;
+	{
+		wmcv::GrowingBlockAllocator pool(upstream, s_chunk_size, 16, s_slab_size, 4);
+		for (size_t i = 0; i < 200; ++i)
+		{
+			(void)pool.allocate();
+		}
+	}
+
+	EXPECT_EQ(upstream.live, 0);
+}
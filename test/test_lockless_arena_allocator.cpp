@@ -1,6 +1,7 @@
 #include "test_pch.h"
 
 #include "wmcv_memory/wmcv_lockless_arena_allocator.h"
+#include "wmcv_memory/wmcv_arena_scope.h"
 #include "wmcv_memory/wmcv_allocator_utility.h"
 
 TEST(test_lockless_arena_allocator, test_allocator_alloc)
@@ -112,3 +113,238 @@ TEST(test_lockless_arena_allocator, test_allocator_clear)
     block = arena.allocate(size);
     EXPECT_NE(block, wmcv::NullBlock());
 }
+
+TEST(test_lockless_arena_allocator, test_allocator_rewind_to_marker)
+{
+    wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+    wmcv::LocklessArenaAllocator arena(mem);
+    
+    auto first = arena.allocate(1_kB);
+    EXPECT_NE(first, wmcv::NullBlock());
+    
+    const auto marker = arena.get_marker();
+    
+    auto scratch = arena.allocate(2_kB);
+    EXPECT_NE(scratch, wmcv::NullBlock());
+    
+    arena.rewind(marker);
+    EXPECT_EQ(arena.get_marker(), marker);
+    
+    auto result = arena.allocate(2_kB);
+    EXPECT_EQ(result, scratch);
+}
+
+TEST(test_lockless_arena_allocator, test_allocator_scope_after_threads_join)
+{
+    wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+    wmcv::LocklessArenaAllocator arena(mem);
+    
+    const auto marker = arena.get_marker();
+    
+    {
+        wmcv::ArenaScope scope(arena);
+        
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([&]
+                                 {
+                auto block = arena.allocate(256);
+                EXPECT_NE(block, wmcv::NullBlock());
+            });
+        }
+        
+        for (auto& t : threads)
+            t.join();
+        
+        EXPECT_EQ(arena.get_marker(), 1_kB);
+    }
+    
+    EXPECT_EQ(arena.get_marker(), marker);
+}
+
+TEST(test_lockless_arena_allocator, test_allocator_rounds_to_granule)
+{
+    wmcv::Block mem{.address = 0x00040004, .size = 4_kB};
+    wmcv::LocklessArenaAllocator arena(mem, 32);
+    
+    auto first = arena.allocate_aligned(1, 8);
+    auto second = arena.allocate_aligned(1, 8);
+    
+    EXPECT_EQ(first.address, 0x00040020);
+    EXPECT_EQ(first.size, 1);
+    EXPECT_EQ(second.address, 0x00040040);
+    EXPECT_EQ(arena.get_marker(), 64);
+}
+
+TEST(test_lockless_arena_allocator, test_allocator_overflow_rolls_back)
+{
+    wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+    wmcv::LocklessArenaAllocator arena(mem);
+    
+    auto block = arena.allocate(3_kB);
+    EXPECT_NE(block, wmcv::NullBlock());
+    
+    block = arena.allocate(2_kB);
+    EXPECT_EQ(block, wmcv::NullBlock());
+    EXPECT_EQ(arena.get_marker(), 3_kB);
+    
+    block = arena.allocate(1_kB);
+    EXPECT_NE(block, wmcv::NullBlock());
+    EXPECT_EQ(arena.get_marker(), 4_kB);
+}
+
+TEST(test_lockless_arena_allocator, test_allocator_threads_exhaust_arena)
+{
+    wmcv::Block mem{.address = 0x00040000, .size = 64_kB};
+    wmcv::LocklessArenaAllocator arena(mem);
+    
+    std::atomic_size_t allocated = 0;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]
+                             {
+            while (arena.allocate(48) != wmcv::NullBlock())
+            {
+                allocated += 48;
+            }
+        });
+    }
+    
+    for (auto& t : threads)
+        t.join();
+    
+    // an overflow that isn't the latest claim leaves the marker past the end,
+    // get_marker clamps it
+    EXPECT_EQ(allocated.load(), (64_kB / 48) * 48);
+    EXPECT_LE(arena.get_marker(), 64_kB);
+    EXPECT_GE(arena.get_marker(), allocated.load());
+}
+
+TEST(test_lockless_arena_allocator, test_allocator_threads_mixed_sizes_do_not_overlap)
+{
+    wmcv::Block mem{.address = 0x00040000, .size = 16_kB};
+    wmcv::LocklessArenaAllocator arena(mem);
+    
+    constexpr size_t thread_count = 4;
+    constexpr std::array<size_t, 4> sizes = { 1_kB, 16u, 256u, 16u };
+    
+    for (size_t round = 0; round < 64; ++round)
+    {
+        std::array<std::vector<wmcv::Block>, thread_count> results;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&, t]
+                                 {
+                // keep going past the first failure, the small requests can still
+                // fit after a large one overflows
+                for (size_t i = 0, failures = 0; failures < 16; ++i)
+                {
+                    const auto block = arena.allocate(sizes[(i + t) % sizes.size()]);
+                    if (block == wmcv::NullBlock())
+                    {
+                        ++failures;
+                        continue;
+                    }
+                    results[t].push_back(block);
+                }
+            });
+        }
+        
+        for (auto& thread : threads)
+            thread.join();
+        
+        std::vector<wmcv::Block> all;
+        for (const auto& blocks : results)
+        {
+            all.insert(all.end(), blocks.begin(), blocks.end());
+        }
+        
+        std::sort(all.begin(), all.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+        for (size_t i = 1; i < all.size(); ++i)
+        {
+            ASSERT_GE(all[i].address, all[i - 1].address + all[i - 1].size);
+        }
+        ASSERT_LE(all.back().address + all.back().size, mem.address + mem.size);
+        
+        arena.reset();
+    }
+}
+
+namespace
+{
+    struct Counted
+    {
+        explicit Counted(std::atomic_size_t& destroyed) noexcept
+            : count(destroyed)
+        {
+        }
+        
+        ~Counted()
+        {
+            ++count;
+        }
+        
+        std::atomic_size_t& count;
+    };
+}
+
+TEST(test_lockless_arena_allocator, test_allocator_create_runs_destructors)
+{
+    alignas(16) std::array<std::byte, 64_kB> buffer = {};
+    wmcv::LocklessArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+    std::atomic_size_t destroyed = 0;
+    
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]
+                             {
+            for (size_t j = 0; j < 100; ++j)
+            {
+                auto* counted = arena.create<Counted>(destroyed);
+                EXPECT_NE(counted, nullptr);
+            }
+        });
+    }
+    
+    for (auto& t : threads)
+        t.join();
+    
+    EXPECT_EQ(destroyed.load(), 0);
+    
+    const auto marker = arena.get_marker();
+    for (size_t i = 0; i < 10; ++i)
+    {
+        (void)arena.create<Counted>(destroyed);
+    }
+    
+    arena.rewind(marker);
+    EXPECT_EQ(destroyed.load(), 10);
+    
+    arena.reset();
+    EXPECT_EQ(destroyed.load(), 410);
+}
+
+TEST(test_lockless_arena_allocator, test_allocator_allocate_n)
+{
+    wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+    wmcv::LocklessArenaAllocator arena(mem);
+    
+    std::array<wmcv::Block, 8> blocks = {};
+    EXPECT_EQ(arena.allocate_n(blocks.size(), 40, 64, blocks), blocks.size());
+    
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        EXPECT_TRUE(wmcv::is_aligned(blocks[i].address, 64));
+        EXPECT_EQ(blocks[i].address, blocks[0].address + i * 64);
+        EXPECT_EQ(blocks[i].size, 40);
+    }
+    
+    std::array<wmcv::Block, 128> too_many = {};
+    const auto marker = arena.get_marker();
+    EXPECT_EQ(arena.allocate_n(too_many.size(), 64, 16, too_many), 0);
+    EXPECT_EQ(arena.get_marker(), marker);
+}
@@ -162,3 +162,291 @@ TEST(test_lockless_block_allocator, test_allocator_clear)
     block = pool.allocate();
     EXPECT_NE(block, wmcv::NullBlock());
 }
+
+TEST(test_lockless_block_allocator, test_allocator_allocate_n_from_multiple_threads)
+{
+    alignas(16) std::array<std::byte, 64_kB> buffer = {};
+    wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+    wmcv::LocklessBlockAllocator pool(mem, 64, 16);
+    
+    constexpr size_t thread_count = 4;
+    std::array<std::vector<wmcv::Block>, thread_count> results;
+    
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+                             {
+            std::array<wmcv::Block, 16> blocks = {};
+            while (const size_t count = pool.allocate_n(blocks.size(), blocks))
+            {
+                results[t].insert(results[t].end(), blocks.begin(), blocks.begin() + static_cast<std::ptrdiff_t>(count));
+            }
+        });
+    }
+    
+    for (auto& thread : threads)
+        thread.join();
+    
+    std::vector<wmcv::Block> all;
+    for (const auto& blocks : results)
+    {
+        all.insert(all.end(), blocks.begin(), blocks.end());
+    }
+    
+    EXPECT_EQ(all.size(), buffer.size() / 64);
+    
+    std::sort(all.begin(), all.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
+
+TEST(test_lockless_block_allocator, test_allocator_construct_does_not_touch_memory)
+{
+    // never dereferenced, chunks are only carved on allocation
+    wmcv::Block mem{.address = 0x00040000, .size = 1_GB};
+    wmcv::LocklessBlockAllocator pool(mem, 64, 16);
+    
+    auto result = pool.allocate();
+    EXPECT_EQ(result.address, 0x00040000);
+    
+    std::array<wmcv::Block, 4> blocks = {};
+    EXPECT_EQ(pool.allocate_n(blocks.size(), blocks), blocks.size());
+    EXPECT_EQ(blocks[0].address, 0x00040000 + 64);
+    EXPECT_EQ(blocks[3].address, 0x00040000 + 4 * 64);
+    
+    pool.reset();
+    
+    result = pool.allocate();
+    EXPECT_EQ(result.address, 0x00040000);
+}
+
+TEST(test_lockless_block_allocator, test_allocator_reset_restores_every_chunk_once)
+{
+    alignas(16) std::array<std::byte, 1_kB> buffer = {};
+    wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+    wmcv::LocklessBlockAllocator pool(mem, 64, 16);
+    
+    for (size_t round = 0; round < 2; ++round)
+    {
+        std::vector<wmcv::Block> blocks;
+        for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+        {
+            blocks.push_back(block);
+        }
+        
+        EXPECT_EQ(blocks.size(), buffer.size() / 64);
+        
+        pool.free(wmcv::address_to_ptr(blocks[3].address));
+        pool.reset();
+    }
+}
+
+TEST(test_lockless_block_allocator, test_allocator_alloc_free_churn_from_multiple_threads)
+{
+    constexpr size_t chunk_size = 64;
+    constexpr size_t thread_count = 8;
+    constexpr size_t held_per_thread = 8;
+    constexpr size_t iterations = 20000;
+    
+    alignas(16) std::array<std::byte, 8_kB> buffer = {};
+    wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+    wmcv::LocklessBlockAllocator pool(mem, chunk_size, 16);
+    
+    std::atomic_size_t corrupted = 0;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+                             {
+            std::array<wmcv::Block, held_per_thread> held = {};
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                auto& slot = held[i % held_per_thread];
+                if (slot != wmcv::NullBlock())
+                {
+                    // a chunk handed to two threads at once would have been overwritten
+                    if (*static_cast<size_t*>(wmcv::address_to_ptr(slot.address + sizeof(size_t))) != t)
+                        ++corrupted;
+                    
+                    pool.free(wmcv::address_to_ptr(slot.address));
+                }
+                
+                slot = pool.allocate();
+                if (slot != wmcv::NullBlock())
+                {
+                    *static_cast<size_t*>(wmcv::address_to_ptr(slot.address + sizeof(size_t))) = t;
+                }
+            }
+            
+            for (const auto& block : held)
+            {
+                pool.free(wmcv::address_to_ptr(block.address));
+            }
+        });
+    }
+    
+    for (auto& thread : threads)
+        thread.join();
+    
+    EXPECT_EQ(corrupted.load(), 0);
+    
+    // no chunk was lost or duplicated
+    std::vector<wmcv::Block> all;
+    for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+    {
+        all.push_back(block);
+    }
+    
+    EXPECT_EQ(all.size(), buffer.size() / chunk_size);
+    
+    std::sort(all.begin(), all.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
+
+TEST(test_lockless_block_allocator, test_allocator_allocate_n_while_chunks_are_overwritten)
+{
+    constexpr size_t chunk_size = 64;
+    constexpr size_t thread_count = 4;
+    constexpr size_t iterations = 20000;
+    
+    alignas(16) std::array<std::byte, 8_kB> buffer = {};
+    wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+    wmcv::LocklessBlockAllocator pool(mem, chunk_size, 16);
+    
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+                             {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                if (t % 2 == 0)
+                {
+                    // a run walked by allocate_n can be popped from under it and its
+                    // links replaced with whatever the new owner writes
+                    const auto block = pool.allocate();
+                    if (block != wmcv::NullBlock())
+                    {
+                        std::atomic_ref<uint32_t>(*static_cast<uint32_t*>(wmcv::address_to_ptr(block.address))).store(0xDEADBEEF, std::memory_order_relaxed);
+                        pool.free(wmcv::address_to_ptr(block.address));
+                    }
+                }
+                else
+                {
+                    std::array<wmcv::Block, 16> blocks = {};
+                    std::array<void*, 16> ptrs = {};
+                    const size_t count = pool.allocate_n(blocks.size(), blocks);
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        ptrs[j] = wmcv::address_to_ptr(blocks[j].address);
+                    }
+                    pool.free_batch(std::span(ptrs).first(count));
+                }
+            }
+        });
+    }
+    
+    for (auto& thread : threads)
+        thread.join();
+    
+    std::vector<wmcv::Block> all;
+    for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+    {
+        all.push_back(block);
+    }
+    
+    EXPECT_EQ(all.size(), buffer.size() / chunk_size);
+    
+    std::sort(all.begin(), all.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
+
+TEST(test_lockless_block_allocator, test_allocator_free_batch)
+{
+    alignas(16) std::array<std::byte, 1_kB> buffer = {};
+    wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+    wmcv::LocklessBlockAllocator pool(mem, 64, 16);
+    
+    std::vector<void*> ptrs;
+    for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+    {
+        ptrs.push_back(wmcv::address_to_ptr(block.address));
+    }
+    
+    pool.free_batch(ptrs);
+    
+    // the batch comes back off the free list in the order it was passed in
+    for (void* ptr : ptrs)
+    {
+        EXPECT_EQ(pool.allocate().address, wmcv::ptr_to_address(ptr));
+    }
+    EXPECT_EQ(pool.allocate(), wmcv::NullBlock());
+}
+
+TEST(test_lockless_block_allocator, test_allocator_free_chain_splices_onto_free_list)
+{
+    alignas(16) std::array<std::byte, 1_kB> buffer = {};
+    wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+    wmcv::LocklessBlockAllocator pool(mem, 64, 16);
+    
+    auto a = pool.allocate();
+    auto b = pool.allocate();
+    auto c = pool.allocate();
+    auto d = pool.allocate();
+    
+    pool.free(wmcv::address_to_ptr(d.address));
+    
+    pool.chain(wmcv::address_to_ptr(a.address), wmcv::address_to_ptr(b.address));
+    pool.chain(wmcv::address_to_ptr(b.address), wmcv::address_to_ptr(c.address));
+    pool.free_chain(wmcv::address_to_ptr(a.address), wmcv::address_to_ptr(c.address));
+    
+    EXPECT_EQ(pool.allocate(), a);
+    EXPECT_EQ(pool.allocate(), b);
+    EXPECT_EQ(pool.allocate(), c);
+    EXPECT_EQ(pool.allocate(), d);
+}
+
+TEST(test_lockless_block_allocator, test_allocator_free_batch_from_multiple_threads)
+{
+    constexpr size_t chunk_size = 64;
+    constexpr size_t thread_count = 8;
+    constexpr size_t batch_size = 16;
+    constexpr size_t iterations = 2000;
+    
+    alignas(16) std::array<std::byte, 16_kB> buffer = {};
+    wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+    wmcv::LocklessBlockAllocator pool(mem, chunk_size, 16);
+    
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&]
+                             {
+            std::array<wmcv::Block, batch_size> blocks = {};
+            std::array<void*, batch_size> ptrs = {};
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                const size_t count = pool.allocate_n(batch_size, blocks);
+                for (size_t j = 0; j < count; ++j)
+                {
+                    ptrs[j] = wmcv::address_to_ptr(blocks[j].address);
+                }
+                pool.free_batch(std::span(ptrs).first(count));
+            }
+        });
+    }
+    
+    for (auto& thread : threads)
+        thread.join();
+    
+    std::vector<wmcv::Block> all;
+    for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+    {
+        all.push_back(block);
+    }
+    
+    EXPECT_EQ(all.size(), buffer.size() / chunk_size);
+    
+    std::sort(all.begin(), all.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
@@ -0,0 +1,131 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_magazine_allocator.h"
+#include "wmcv_memory/wmcv_lockless_block_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	auto DrainPool(wmcv::LocklessBlockAllocator& pool) -> size_t
+	{
+		size_t count = 0;
+		while (pool.allocate() != wmcv::NullBlock())
+		{
+			++count;
+		}
+		return count;
+	}
+}
+
+TEST(test_magazine_allocator, test_allocator_alloc)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::LocklessBlockAllocator pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 32, 16);
+	wmcv::MagazineDepot depot(pool, 8);
+	wmcv::MagazineCache cache(depot);
+
+	auto result = cache.allocate();
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.size, 32);
+	EXPECT_TRUE(wmcv::is_address_in_range(result.address, wmcv::ptr_to_address(buffer.data()), buffer.size()));
+
+	// the first allocation loads a whole magazine
+	EXPECT_EQ(cache.cached(), 7);
+}
+
+TEST(test_magazine_allocator, test_allocator_free_reuses_cached_chunk)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::LocklessBlockAllocator pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 32, 16);
+	wmcv::MagazineDepot depot(pool, 8);
+	wmcv::MagazineCache cache(depot);
+
+	auto first = cache.allocate();
+	cache.free(wmcv::address_to_ptr(first.address));
+
+	auto second = cache.allocate();
+	EXPECT_EQ(first, second);
+}
+
+TEST(test_magazine_allocator, test_allocator_full_magazines_go_to_depot)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::LocklessBlockAllocator pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 32, 16);
+	wmcv::MagazineDepot depot(pool, 8);
+
+	std::vector<wmcv::Block> blocks;
+	{
+		wmcv::MagazineCache cache(depot);
+		for (size_t i = 0; i < 40; ++i)
+		{
+			blocks.push_back(cache.allocate());
+		}
+
+		for (const auto& block : blocks)
+		{
+			cache.free(wmcv::address_to_ptr(block.address));
+		}
+
+		// loaded and previous hold 16, the other 24 went to the depot
+		EXPECT_EQ(cache.cached(), 16);
+		EXPECT_EQ(depot.full_magazines(), 3);
+	}
+
+	EXPECT_EQ(depot.full_magazines(), 5);
+
+	wmcv::MagazineCache other(depot);
+	EXPECT_NE(other.allocate(), wmcv::NullBlock());
+	EXPECT_EQ(depot.full_magazines(), 4);
+}
+
+TEST(test_magazine_allocator, test_allocator_exhausted)
+{
+	alignas(16) std::array<std::byte, 256> buffer = {};
+	wmcv::LocklessBlockAllocator pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 32, 16);
+	wmcv::MagazineDepot depot(pool, 16);
+	wmcv::MagazineCache cache(depot);
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		EXPECT_NE(cache.allocate(), wmcv::NullBlock());
+	}
+
+	EXPECT_EQ(cache.allocate(), wmcv::NullBlock());
+}
+
+TEST(test_magazine_allocator, test_allocator_thread_exit_returns_chunks)
+{
+	alignas(16) std::array<std::byte, 16_kB> buffer = {};
+	wmcv::LocklessBlockAllocator pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 64, 16);
+
+	{
+		wmcv::MagazineDepot depot(pool, 8);
+
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([&]
+			{
+				wmcv::MagazineCache cache(depot);
+				std::array<wmcv::Block, 20> held = {};
+				for (size_t i = 0; i < 1000; ++i)
+				{
+					auto& slot = held[i % held.size()];
+					cache.free(wmcv::address_to_ptr(slot.address));
+					slot = cache.allocate();
+					EXPECT_NE(slot, wmcv::NullBlock());
+				}
+
+				for (const auto& block : held)
+				{
+					cache.free(wmcv::address_to_ptr(block.address));
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	EXPECT_EQ(DrainPool(pool), buffer.size() / 64);
+}
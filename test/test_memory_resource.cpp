@@ -0,0 +1,147 @@
+#include "test_pch.h"
+#include "wmcv_freelist_first_fit_policy.h"
+
+#include "wmcv_memory/wmcv_memory_resource.h"
+#include "wmcv_memory/wmcv_arena_allocator.h"
+#include "wmcv_memory/wmcv_stack_allocator.h"
+#include "wmcv_memory/wmcv_block_allocator.h"
+#include "wmcv_memory/wmcv_buddy_allocator.h"
+#include "wmcv_memory/wmcv_freelist_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+TEST(test_memory_resource, test_arena_resource_vector)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	wmcv::MemoryResourceAdapter resource(arena);
+
+	std::pmr::vector<int> values(&resource);
+	for (int i = 0; i < 64; ++i)
+	{
+		values.push_back(i);
+	}
+
+	EXPECT_EQ(values.size(), 64);
+	EXPECT_TRUE(wmcv::is_address_in_range(wmcv::ptr_to_address(values.data()), wmcv::ptr_to_address(buffer.data()), buffer.size()));
+}
+
+TEST(test_memory_resource, test_arena_resource_alignment)
+{
+	std::array<std::byte, 4_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	wmcv::MemoryResourceAdapter resource(arena);
+
+	void* ptr = resource.allocate(8, 1);
+	EXPECT_NE(ptr, nullptr);
+
+	ptr = resource.allocate(64, 64);
+	EXPECT_TRUE(wmcv::is_ptr_aligned(ptr, 64));
+}
+
+TEST(test_memory_resource, test_arena_resource_exhausted_throws)
+{
+	std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ArenaAllocator arena({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	wmcv::MemoryResourceAdapter resource(arena);
+
+	EXPECT_THROW((void)resource.allocate(2_kB), std::bad_alloc);
+}
+
+TEST(test_memory_resource, test_stack_resource_lifo)
+{
+	std::array<std::byte, 4_kB> buffer = {};
+	wmcv::StackAllocator stack({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	wmcv::MemoryResourceAdapter resource(stack);
+
+	void* first = resource.allocate(256, 32);
+	EXPECT_TRUE(wmcv::is_ptr_aligned(first, 32));
+	resource.deallocate(first, 256, 32);
+
+	void* second = resource.allocate(256, 32);
+	EXPECT_EQ(first, second);
+	resource.deallocate(second, 256, 32);
+}
+
+TEST(test_memory_resource, test_block_resource_list)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::BlockAllocator pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 32, 16);
+	wmcv::MemoryResourceAdapter resource(pool);
+
+	{
+		std::pmr::list<int> values(&resource);
+		for (int i = 0; i < 100; ++i)
+		{
+			values.push_back(i);
+		}
+
+		EXPECT_EQ(values.size(), 100);
+	}
+
+	std::pmr::list<int> values(&resource);
+	for (int i = 0; i < 100; ++i)
+	{
+		values.push_back(i);
+	}
+}
+
+TEST(test_memory_resource, test_block_resource_rejects_large_requests)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::BlockAllocator pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 32, 16);
+	wmcv::MemoryResourceAdapter resource(pool);
+
+	EXPECT_THROW((void)resource.allocate(64, 16), std::bad_alloc);
+	EXPECT_THROW((void)resource.allocate(32, 64), std::bad_alloc);
+}
+
+TEST(test_memory_resource, test_buddy_resource_unordered_map)
+{
+	alignas(16) std::array<std::byte, 16_kB> buffer = {};
+	wmcv::BuddyAllocator buddy({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()}, 16);
+	wmcv::MemoryResourceAdapter resource(buddy);
+
+	std::pmr::unordered_map<int, int> values(&resource);
+	for (int i = 0; i < 32; ++i)
+	{
+		values.emplace(i, i * 2);
+	}
+
+	EXPECT_EQ(values.size(), 32);
+	EXPECT_EQ(values.at(16), 32);
+	EXPECT_THROW((void)resource.allocate(16, 32), std::bad_alloc);
+}
+
+TEST(test_memory_resource, test_freelist_resource_vector)
+{
+	std::array<std::byte, 4_kB> buffer = {};
+	wmcv::FreeListAllocator<wmcv::FreeListFirstFitPolicy> freelist({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+	wmcv::MemoryResourceAdapter resource(freelist);
+
+	for (int round = 0; round < 8; ++round)
+	{
+		std::pmr::vector<int> values(&resource);
+		for (int i = 0; i < 128; ++i)
+		{
+			values.push_back(i);
+		}
+		EXPECT_EQ(values.size(), 128);
+	}
+}
+
+TEST(test_memory_resource, test_resource_is_equal)
+{
+	std::array<std::byte, 1_kB> buffer = {};
+	const wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::ArenaAllocator arena(mem);
+	wmcv::ArenaAllocator other_arena(mem);
+
+	wmcv::MemoryResourceAdapter resource(arena);
+	wmcv::MemoryResourceAdapter same_arena(arena);
+	wmcv::MemoryResourceAdapter other(other_arena);
+
+	EXPECT_TRUE(resource.is_equal(resource));
+	EXPECT_TRUE(resource.is_equal(same_arena));
+	EXPECT_FALSE(resource.is_equal(other));
+	EXPECT_FALSE(resource.is_equal(*std::pmr::new_delete_resource()));
+}
@@ -0,0 +1,152 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_object_pool.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	struct Tracked
+	{
+		explicit Tracked(int v, int& live) noexcept : value(v), counter(&live) { ++*counter; }
+		Tracked(Tracked&& that) noexcept : value(that.value), counter(that.counter) { ++*counter; }
+		~Tracked() noexcept { --*counter; }
+
+		Tracked& operator=(Tracked&&) = delete;
+
+		int value;
+		int* counter;
+	};
+}
+
+TEST(test_object_pool, test_pool_create)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ObjectPool<uint64_t> pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	static_assert(sizeof(wmcv::ObjectHandle) == 4);
+
+	auto handle = pool.create(42u);
+	ASSERT_NE(handle, wmcv::NullHandle());
+	auto* obj = pool.get(handle);
+	ASSERT_NE(obj, nullptr);
+	EXPECT_EQ(*obj, 42u);
+	EXPECT_EQ(pool.size(), 1);
+	EXPECT_TRUE(wmcv::is_address_in_range(wmcv::ptr_to_address(obj), wmcv::ptr_to_address(buffer.data()), buffer.size()));
+}
+
+TEST(test_object_pool, test_pool_capacity_fits_in_block)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ObjectPool<uint64_t> pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	// 8 bytes of object plus 12 of slot and back reference each
+	EXPECT_EQ(pool.capacity(), 51);
+
+	for (size_t i = 0; i < pool.capacity(); ++i)
+	{
+		auto handle = pool.create(i);
+		ASSERT_NE(handle, wmcv::NullHandle());
+		auto* obj = pool.get(handle);
+		ASSERT_NE(obj, nullptr);
+		ASSERT_LE(wmcv::ptr_to_address(obj + 1), wmcv::ptr_to_address(buffer.data() + buffer.size()));
+	}
+
+	EXPECT_EQ(pool.create(0u), wmcv::NullHandle());
+}
+
+TEST(test_object_pool, test_pool_stale_handle_doesnt_resolve)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ObjectPool<uint64_t> pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	auto first = pool.create(1u);
+	pool.destroy(first);
+	EXPECT_EQ(pool.get(first), nullptr);
+	EXPECT_FALSE(pool.contains(first));
+
+	// the slot is reused with a new generation
+	auto second = pool.create(2u);
+	EXPECT_EQ(second.index(), first.index());
+	EXPECT_NE(second.generation(), first.generation());
+	EXPECT_EQ(pool.get(first), nullptr);
+	auto* obj = pool.get(second);
+	ASSERT_NE(obj, nullptr);
+	EXPECT_EQ(*obj, 2u);
+}
+
+TEST(test_object_pool, test_pool_null_handle_doesnt_resolve)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ObjectPool<uint64_t> pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	(void)pool.create(1u);
+	EXPECT_EQ(pool.get(wmcv::NullHandle()), nullptr);
+	pool.destroy(wmcv::NullHandle());
+	EXPECT_EQ(pool.size(), 1);
+}
+
+TEST(test_object_pool, test_pool_objects_stay_dense)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::ObjectPool<uint64_t> pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	std::vector<wmcv::ObjectHandle> handles;
+	for (uint64_t i = 0; i < 10; ++i)
+	{
+		handles.push_back(pool.create(i));
+	}
+
+	pool.destroy(handles[2]);
+	pool.destroy(handles[7]);
+	pool.destroy(handles[0]);
+
+	ASSERT_EQ(pool.objects().size(), 7);
+	EXPECT_EQ(std::accumulate(pool.objects().begin(), pool.objects().end(), uint64_t{0}), uint64_t{45 - 2 - 7 - 0});
+
+	// the remaining handles still find their objects after being moved
+	for (size_t i : {1u, 3u, 4u, 5u, 6u, 8u, 9u})
+	{
+		auto* obj = pool.get(handles[i]);
+		ASSERT_NE(obj, nullptr);
+		EXPECT_EQ(*obj, i);
+	}
+
+	for (size_t i = 0; i < pool.size(); ++i)
+	{
+		EXPECT_EQ(pool.get(pool.handle_at(i)), &pool.objects()[i]);
+	}
+}
+
+TEST(test_object_pool, test_pool_destroys_objects)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	int live = 0;
+	{
+		wmcv::ObjectPool<Tracked> pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+		auto first = pool.create(1, live);
+		(void)pool.create(2, live);
+		(void)pool.create(3, live);
+		EXPECT_EQ(live, 3);
+
+		pool.destroy(first);
+		EXPECT_EQ(live, 2);
+		EXPECT_EQ(pool.objects()[0].value, 3);
+	}
+
+	EXPECT_EQ(live, 0);
+}
+
+TEST(test_object_pool, test_pool_clear)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::ObjectPool<uint64_t> pool({.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()});
+
+	auto first = pool.create(1u);
+	auto second = pool.create(2u);
+	pool.clear();
+
+	EXPECT_EQ(pool.size(), 0);
+	EXPECT_EQ(pool.get(first), nullptr);
+	EXPECT_EQ(pool.get(second), nullptr);
+}
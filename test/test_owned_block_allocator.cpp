@@ -0,0 +1,208 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_owned_block_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+TEST(test_owned_block_allocator, test_allocator_alloc)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::OwnedBlockAllocator pool(mem, 64, 16);
+
+	auto result = pool.allocate();
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.size, 64);
+	EXPECT_TRUE(pool.owns(wmcv::address_to_ptr(result.address)));
+}
+
+TEST(test_owned_block_allocator, test_allocator_owner_free_is_local)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::OwnedBlockAllocator pool(mem, 64, 16);
+
+	auto first = pool.allocate();
+	pool.free(wmcv::address_to_ptr(first.address));
+
+	EXPECT_EQ(pool.drain_remote_frees(), 0);
+	EXPECT_EQ(pool.allocate(), first);
+}
+
+TEST(test_owned_block_allocator, test_allocator_remote_frees_drained_on_exhaustion)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::OwnedBlockAllocator pool(mem, 64, 16);
+
+	std::vector<wmcv::Block> blocks;
+	for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+	{
+		blocks.push_back(block);
+	}
+
+	std::thread remote([&]
+	{
+		for (const auto& block : blocks)
+		{
+			pool.free(wmcv::address_to_ptr(block.address));
+		}
+	});
+	remote.join();
+
+	// every chunk comes back once the owner runs dry and takes the remote frees
+	std::vector<wmcv::Block> reallocated;
+	for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+	{
+		reallocated.push_back(block);
+	}
+
+	std::sort(blocks.begin(), blocks.end(), [](auto lhs, auto rhs) { return lhs.address < rhs.address; });
+	std::sort(reallocated.begin(), reallocated.end(), [](auto lhs, auto rhs) { return lhs.address < rhs.address; });
+	EXPECT_EQ(blocks, reallocated);
+}
+
+TEST(test_owned_block_allocator, test_allocator_claim)
+{
+	alignas(16) std::array<std::byte, 1_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::OwnedBlockAllocator pool(mem, 64, 16);
+
+	wmcv::Block block = wmcv::NullBlock();
+	std::thread owner([&]
+	{
+		pool.claim();
+		block = pool.allocate();
+	});
+	owner.join();
+
+	// this thread is now remote to the pool
+	pool.free(wmcv::address_to_ptr(block.address));
+	EXPECT_EQ(pool.drain_remote_frees(), 1);
+}
+
+TEST(test_owned_block_allocator, test_allocator_claim_while_remote_threads_free)
+{
+	alignas(16) std::array<std::byte, 16_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::OwnedBlockAllocator pool(mem, 64, 16);
+
+	std::vector<void*> chunks;
+	for (auto block = pool.allocate(); block != wmcv::NullBlock(); block = pool.allocate())
+	{
+		chunks.push_back(wmcv::address_to_ptr(block.address));
+	}
+
+	// this thread is done with the pool, ownership moves while another thread
+	// is still handing chunks back
+	std::atomic_bool started = false;
+	std::thread remote([&]
+	{
+		started = true;
+		for (void* ptr : chunks)
+		{
+			pool.free(ptr);
+		}
+	});
+
+	size_t reclaimed = 0;
+	std::thread owner([&]
+	{
+		while (!started)
+		{
+		}
+		pool.claim();
+		remote.join();
+
+		while (pool.allocate() != wmcv::NullBlock())
+		{
+			++reclaimed;
+		}
+	});
+	owner.join();
+
+	EXPECT_EQ(reclaimed, chunks.size());
+}
+
+TEST(test_owned_block_allocator, test_group_free_routes_by_address)
+{
+	alignas(16) std::array<std::byte, 4_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::OwnedBlockAllocatorGroup<4> group(mem, 64, 16);
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		auto block = group.pool(i).allocate();
+		ASSERT_NE(block, wmcv::NullBlock());
+		EXPECT_EQ(&group.pool_of(wmcv::address_to_ptr(block.address)), &group.pool(i));
+
+		group.free(wmcv::address_to_ptr(block.address));
+		EXPECT_EQ(group.pool(i).allocate(), block);
+	}
+}
+
+TEST(test_owned_block_allocator, test_group_producer_consumer)
+{
+	constexpr size_t thread_count = 4;
+	constexpr size_t iterations = 20000;
+
+	alignas(16) std::array<std::byte, 64_kB> buffer = {};
+	wmcv::Block mem{.address = wmcv::ptr_to_address(buffer.data()), .size = buffer.size()};
+	wmcv::OwnedBlockAllocatorGroup<thread_count> group(mem, 64, 16);
+
+	// each thread allocates from its own pool and hands the chunk to the next
+	// thread along, which frees it
+	std::array<std::atomic<void*>, thread_count> mailboxes = {};
+	std::atomic_size_t failed = 0;
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&, t]
+		{
+			auto& pool = group.pool(t);
+			pool.claim();
+
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				auto block = pool.allocate();
+				if (block == wmcv::NullBlock())
+				{
+					++failed;
+					continue;
+				}
+
+				void* ptr = wmcv::address_to_ptr(block.address);
+				group.free(mailboxes[(t + 1) % thread_count].exchange(ptr));
+				group.free(mailboxes[t].exchange(nullptr));
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (auto& mailbox : mailboxes)
+	{
+		group.free(mailbox.exchange(nullptr));
+	}
+
+	EXPECT_EQ(failed.load(), 0);
+
+	// every chunk of every pool is free again
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		group.pool(t).claim();
+
+		std::vector<wmcv::Block> all;
+		for (auto block = group.pool(t).allocate(); block != wmcv::NullBlock(); block = group.pool(t).allocate())
+		{
+			all.push_back(block);
+		}
+
+		EXPECT_EQ(all.size(), 16_kB / 64);
+		std::sort(all.begin(), all.end(), [](auto lhs, auto rhs) { return lhs.address < rhs.address; });
+		EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+	}
+}
@@ -5,16 +5,24 @@
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <cstdlib>
 
 #include <type_traits>
+#include <concepts>
+#include <bit>
 #include <algorithm>
 #include <numeric>
 #include <memory>
 #include <array>
 #include <span>
+#include <memory_resource>
+#include <vector>
+#include <list>
+#include <unordered_map>
 #include <stack>
 #include <utility>
 #include <thread>
+#include <mutex>
 
 #include <gtest/gtest.h>
 
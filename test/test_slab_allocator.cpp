@@ -0,0 +1,178 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_slab_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+namespace
+{
+	// room for slabCount slabs once the start is aligned to the slab size
+	auto MakeSlabBuffer(size_t slabCount) -> std::vector<std::byte>
+	{
+		return std::vector<std::byte>((slabCount + 1) * wmcv::SlabAllocator::SlabSize);
+	}
+
+	// Exactly the slabs MakeSlabBuffer made room for, starting on a slab boundary,
+	// so the slab count doesn't depend on where the buffer landed
+	auto ToBlock(std::vector<std::byte>& buffer) -> wmcv::Block
+	{
+		const uintptr_t start = wmcv::align(wmcv::ptr_to_address(buffer.data()), wmcv::SlabAllocator::SlabSize);
+		return {.address = start, .size = buffer.size() - wmcv::SlabAllocator::SlabSize};
+	}
+}
+
+TEST(test_slab_allocator, test_allocator_size_classes)
+{
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(0)), 16);
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(1)), 16);
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(16)), 16);
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(17)), 32);
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(129)), 160);
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(1000)), 1024);
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(3000)), 3072);
+	EXPECT_EQ(wmcv::SlabAllocator::class_size(wmcv::SlabAllocator::size_class(4096)), 4096);
+
+	for (size_t size = 1; size <= wmcv::SlabAllocator::MaxSize; ++size)
+	{
+		const size_t sizeClass = wmcv::SlabAllocator::size_class(size);
+		ASSERT_GE(wmcv::SlabAllocator::class_size(sizeClass), size);
+		ASSERT_TRUE(sizeClass == 0 || wmcv::SlabAllocator::class_size(sizeClass - 1) < size);
+	}
+}
+
+TEST(test_slab_allocator, test_allocator_alloc)
+{
+	auto buffer = MakeSlabBuffer(4);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	auto result = slab.allocate(100);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.size, 112);
+	EXPECT_TRUE(wmcv::is_address_in_range(result.address, ToBlock(buffer).address, buffer.size()));
+	EXPECT_TRUE(wmcv::is_aligned(result.address, 16));
+}
+
+TEST(test_slab_allocator, test_allocator_alloc_every_class)
+{
+	auto buffer = MakeSlabBuffer(wmcv::detail::SlabClassCount);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	for (size_t sizeClass = 0; sizeClass < wmcv::detail::SlabClassCount; ++sizeClass)
+	{
+		const size_t size = wmcv::SlabAllocator::class_size(sizeClass);
+		auto result = slab.allocate(size);
+		ASSERT_NE(result, wmcv::NullBlock());
+		EXPECT_EQ(result.size, size);
+
+		std::memset(wmcv::address_to_ptr(result.address), 0xff, result.size);
+	}
+}
+
+TEST(test_slab_allocator, test_allocator_alloc_too_large)
+{
+	auto buffer = MakeSlabBuffer(1);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	auto result = slab.allocate(wmcv::SlabAllocator::MaxSize + 1);
+	EXPECT_EQ(result, wmcv::NullBlock());
+}
+
+TEST(test_slab_allocator, test_allocator_alloc_aligned)
+{
+	auto buffer = MakeSlabBuffer(4);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	auto result = slab.allocate_aligned(24, 64);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_GE(result.size, 24);
+	EXPECT_TRUE(wmcv::is_aligned(result.address, 64));
+
+	result = slab.allocate_aligned(24, 64);
+	EXPECT_TRUE(wmcv::is_aligned(result.address, 64));
+
+	result = slab.allocate_aligned(100, 1024);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_TRUE(wmcv::is_aligned(result.address, 1024));
+}
+
+TEST(test_slab_allocator, test_allocator_free_reuses_chunk)
+{
+	auto buffer = MakeSlabBuffer(2);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	auto first = slab.allocate(48);
+	(void)slab.allocate(48);
+	slab.free(wmcv::address_to_ptr(first.address));
+
+	auto second = slab.allocate(40);
+	EXPECT_EQ(first, second);
+}
+
+TEST(test_slab_allocator, test_allocator_sized_free_reuses_chunk)
+{
+	auto buffer = MakeSlabBuffer(2);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	auto first = slab.allocate(300);
+	(void)slab.allocate(300);
+	slab.free(wmcv::address_to_ptr(first.address), 300);
+
+	auto second = slab.allocate(300);
+	EXPECT_EQ(first, second);
+}
+
+TEST(test_slab_allocator, test_allocator_empty_slab_is_shared_between_classes)
+{
+	auto buffer = MakeSlabBuffer(2);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	// fill both slabs with 4 KiB chunks
+	std::vector<wmcv::Block> blocks;
+	for (auto block = slab.allocate(4_kB); block != wmcv::NullBlock(); block = slab.allocate(4_kB))
+	{
+		blocks.push_back(block);
+	}
+	ASSERT_FALSE(blocks.empty());
+	EXPECT_EQ(slab.allocate(16), wmcv::NullBlock());
+
+	for (const auto& block : blocks)
+	{
+		slab.free(wmcv::address_to_ptr(block.address));
+	}
+
+	// one slab stays with the 4 KiB class, the other is free for anyone
+	auto small = slab.allocate(16);
+	EXPECT_NE(small, wmcv::NullBlock());
+	EXPECT_NE(slab.allocate(4_kB), wmcv::NullBlock());
+	EXPECT_EQ(slab.allocate(64), wmcv::NullBlock());
+}
+
+TEST(test_slab_allocator, test_allocator_not_enough_space)
+{
+	auto buffer = MakeSlabBuffer(1);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	size_t count = 0;
+	while (slab.allocate(2_kB) != wmcv::NullBlock())
+	{
+		++count;
+	}
+
+	EXPECT_GT(count, 0);
+	EXPECT_LT(count, wmcv::SlabAllocator::SlabSize / 2_kB);
+}
+
+TEST(test_slab_allocator, test_allocator_reset)
+{
+	auto buffer = MakeSlabBuffer(1);
+	wmcv::SlabAllocator slab(ToBlock(buffer));
+
+	auto first = slab.allocate(64);
+	while (slab.allocate(64) != wmcv::NullBlock())
+	{
+	}
+
+	slab.reset();
+
+	auto second = slab.allocate(64);
+	EXPECT_EQ(first, second);
+}
@@ -0,0 +1,163 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_thread_local_arena_buffer.h"
+#include "wmcv_memory/wmcv_lockless_arena_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+TEST(test_thread_local_arena_buffer, test_allocator_alloc)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::LocklessArenaAllocator arena(mem);
+	wmcv::ThreadLocalArenaBuffer buffer(arena, 1_kB);
+
+	auto result = buffer.allocate(64);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.address, 0x00040000);
+	EXPECT_EQ(result.size, 64);
+
+	EXPECT_EQ(arena.get_marker(), 1_kB);
+	EXPECT_EQ(buffer.remaining(), 1_kB - 64);
+}
+
+TEST(test_thread_local_arena_buffer, test_allocator_alloc_aligned)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::LocklessArenaAllocator arena(mem);
+	wmcv::ThreadLocalArenaBuffer buffer(arena, 1_kB);
+
+	constexpr size_t alignment = 128;
+
+	auto result = buffer.allocate_aligned(8, alignment);
+	EXPECT_TRUE(wmcv::is_aligned(result.address, alignment));
+
+	result = buffer.allocate_aligned(8, alignment);
+	EXPECT_TRUE(wmcv::is_aligned(result.address, alignment));
+	EXPECT_EQ(arena.get_marker(), 1_kB);
+}
+
+TEST(test_thread_local_arena_buffer, test_allocator_refill_aligned_to_granule)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::LocklessArenaAllocator arena(mem);
+	wmcv::ThreadLocalArenaBuffer buffer(arena, 1_kB);
+
+	(void)arena.allocate(16);
+
+	// the buffer follows straight on from the arena's last granule
+	auto result = buffer.allocate(16);
+	EXPECT_EQ(result.address, 0x00040000 + 16);
+	EXPECT_EQ(arena.get_marker(), 16 + 1_kB);
+
+	wmcv::LocklessArenaAllocator lineArena(mem, wmcv::CacheLineSize);
+	wmcv::ThreadLocalArenaBuffer lineBuffer(lineArena, 1_kB);
+
+	(void)lineArena.allocate(16);
+
+	result = lineBuffer.allocate(16);
+	EXPECT_TRUE(wmcv::is_aligned(result.address, wmcv::CacheLineSize));
+}
+
+TEST(test_thread_local_arena_buffer, test_allocator_refills_when_exhausted)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::LocklessArenaAllocator arena(mem);
+	wmcv::ThreadLocalArenaBuffer buffer(arena, 1_kB);
+
+	for (size_t i = 0; i < 5; ++i)
+	{
+		auto result = buffer.allocate(256);
+		EXPECT_NE(result, wmcv::NullBlock());
+	}
+
+	EXPECT_EQ(arena.get_marker(), 2_kB);
+}
+
+TEST(test_thread_local_arena_buffer, test_allocator_large_request_goes_to_arena)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::LocklessArenaAllocator arena(mem);
+	wmcv::ThreadLocalArenaBuffer buffer(arena, 1_kB);
+
+	auto result = buffer.allocate(2_kB);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(arena.get_marker(), 2_kB);
+	EXPECT_EQ(buffer.remaining(), 0);
+}
+
+TEST(test_thread_local_arena_buffer, test_allocator_arena_tail_smaller_than_buffer)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 1536};
+	wmcv::LocklessArenaAllocator arena(mem);
+	wmcv::ThreadLocalArenaBuffer buffer(arena, 1_kB);
+
+	auto result = buffer.allocate(512);
+	EXPECT_NE(result, wmcv::NullBlock());
+	result = buffer.allocate(512);
+	EXPECT_NE(result, wmcv::NullBlock());
+
+	result = buffer.allocate(256);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(arena.get_marker(), 1280);
+
+	result = buffer.allocate(512);
+	EXPECT_EQ(result, wmcv::NullBlock());
+}
+
+TEST(test_thread_local_arena_buffer, test_allocator_reset_invalidates_buffers)
+{
+	wmcv::Block mem{.address = 0x00040000, .size = 4_kB};
+	wmcv::LocklessArenaAllocator arena(mem);
+	wmcv::ThreadLocalArenaBuffer buffer(arena, 1_kB);
+
+	auto first = buffer.allocate(64);
+	EXPECT_NE(first, wmcv::NullBlock());
+
+	arena.reset();
+
+	auto other = arena.allocate(64);
+	EXPECT_EQ(other.address, first.address);
+
+	auto result = buffer.allocate(64);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_GE(result.address, other.address + other.size);
+}
+
+TEST(test_thread_local_arena_buffer, test_allocator_threads_allocate_disjoint_blocks)
+{
+	constexpr size_t thread_count = 4;
+	constexpr size_t allocs_per_thread = 1000;
+	constexpr size_t alloc_size = 32;
+
+	wmcv::Block mem{.address = 0x00040000, .size = 1_MB};
+	wmcv::LocklessArenaAllocator arena(mem);
+
+	std::array<std::vector<wmcv::Block>, thread_count> results;
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&, t]
+		{
+			wmcv::ThreadLocalArenaBuffer buffer(arena, 4_kB);
+			for (size_t i = 0; i < allocs_per_thread; ++i)
+			{
+				results[t].push_back(buffer.allocate(alloc_size));
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	std::vector<wmcv::Block> all;
+	for (const auto& blocks : results)
+	{
+		all.insert(all.end(), blocks.begin(), blocks.end());
+	}
+
+	std::sort(all.begin(), all.end(), [](const wmcv::Block& lhs, const wmcv::Block& rhs) { return lhs.address < rhs.address; });
+	for (size_t i = 1; i < all.size(); ++i)
+	{
+		EXPECT_NE(all[i - 1], wmcv::NullBlock());
+		EXPECT_LE(all[i - 1].address + all[i - 1].size, all[i].address);
+	}
+}
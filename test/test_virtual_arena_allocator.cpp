@@ -0,0 +1,92 @@
+#include "test_pch.h"
+
+#include "wmcv_memory/wmcv_virtual_arena_allocator.h"
+#include "wmcv_memory/wmcv_allocator_utility.h"
+
+TEST(test_virtual_arena_allocator, test_allocator_alloc)
+{
+	wmcv::VirtualArenaAllocator arena(1_GB);
+	EXPECT_EQ(arena.reserved_size(), 1_GB);
+	EXPECT_EQ(arena.committed_size(), 0);
+
+	auto result = arena.allocate(1_kB);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_EQ(result.size, 1_kB);
+
+	wmcv::zero_memory(wmcv::address_to_ptr(result.address), result.size);
+}
+
+TEST(test_virtual_arena_allocator, test_allocator_alloc_aligned)
+{
+	wmcv::VirtualArenaAllocator arena(1_MB);
+
+	constexpr size_t alignment = 32;
+	constexpr size_t size = 64;
+
+	auto result = arena.allocate_aligned(8, 8);
+	EXPECT_NE(result, wmcv::NullBlock());
+
+	result = arena.allocate_aligned(size, alignment);
+	EXPECT_NE(result, wmcv::NullBlock());
+	EXPECT_TRUE(wmcv::is_aligned(result.address, alignment));
+}
+
+TEST(test_virtual_arena_allocator, test_allocator_commits_on_demand)
+{
+	wmcv::VirtualArenaAllocator arena(1_GB, 64_kB);
+
+	auto block = arena.allocate(1_kB);
+	EXPECT_NE(block, wmcv::NullBlock());
+	EXPECT_EQ(arena.committed_size(), 64_kB);
+
+	block = arena.allocate(1_MB);
+	EXPECT_NE(block, wmcv::NullBlock());
+	EXPECT_EQ(arena.committed_size(), wmcv::align(1_MB + 1_kB, 64_kB));
+
+	wmcv::zero_memory(wmcv::address_to_ptr(block.address), block.size);
+}
+
+TEST(test_virtual_arena_allocator, test_allocator_alloc_too_large)
+{
+	wmcv::VirtualArenaAllocator arena(1_MB);
+
+	auto result = arena.allocate(2_MB);
+	EXPECT_EQ(result, wmcv::NullBlock());
+	EXPECT_EQ(arena.committed_size(), 0);
+}
+
+TEST(test_virtual_arena_allocator, test_allocator_clear)
+{
+	wmcv::VirtualArenaAllocator arena(1_MB, 64_kB);
+
+	constexpr size_t size = 768_kB;
+	auto block = arena.allocate(size);
+	EXPECT_NE(block, wmcv::NullBlock());
+
+	block = arena.allocate(size);
+	EXPECT_EQ(block, wmcv::NullBlock());
+
+	arena.reset();
+	EXPECT_EQ(arena.committed_size(), size);
+
+	block = arena.allocate(size);
+	EXPECT_NE(block, wmcv::NullBlock());
+}
+
+TEST(test_virtual_arena_allocator, test_allocator_clear_to_low_water_mark)
+{
+	wmcv::VirtualArenaAllocator arena(1_GB, 64_kB);
+
+	auto block = arena.allocate(16_MB);
+	EXPECT_NE(block, wmcv::NullBlock());
+	EXPECT_EQ(arena.committed_size(), 16_MB);
+
+	arena.reset(100_kB);
+	EXPECT_EQ(arena.committed_size(), 128_kB);
+
+	block = arena.allocate(1_MB);
+	EXPECT_NE(block, wmcv::NullBlock());
+	EXPECT_EQ(arena.committed_size(), 1_MB);
+
+	wmcv::zero_memory(wmcv::address_to_ptr(block.address), block.size);
+}